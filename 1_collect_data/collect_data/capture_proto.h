@@ -0,0 +1,178 @@
+#ifndef CAPTURE_PROTO_H
+#define CAPTURE_PROTO_H
+
+// Protocolo binário de captura (collect_data -> host)
+//
+// Quadro: A5 5A | len | payload[len] | crc16 (LE)
+// Payload: seq (u16) | t_us (u32, instante da 1a amostra) | period_us (u16)
+//          | count (u8) | 1a amostra: 6 x int16 LE
+//          | demais: 6 deltas por amostra (zigzag + varint)
+// Os inteiros são little-endian; o CRC (CCITT, 0x1021, início 0xFFFF) cobre
+// len + payload. seq conta quadros, então o host detecta quadros perdidos.
+// Usado pelo firmware (codificação) e por 1_collect_data/host (decodificação).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define CAPTURE_SYNC0 0xA5
+#define CAPTURE_SYNC1 0x5A
+#define CAPTURE_AXES 6
+#define CAPTURE_SAMPLES_PER_FRAME 10
+
+#define CAPTURE_HEADER_BYTES 9
+#define CAPTURE_MIN_PAYLOAD (CAPTURE_HEADER_BYTES + CAPTURE_AXES * 2)
+// Delta de int16 cabe em 17 bits: no máximo 3 bytes de varint
+#define CAPTURE_MAX_PAYLOAD (CAPTURE_MIN_PAYLOAD + (CAPTURE_SAMPLES_PER_FRAME - 1) * CAPTURE_AXES * 3)
+#define CAPTURE_MAX_FRAME (3 + CAPTURE_MAX_PAYLOAD + 2)
+
+#if CAPTURE_MAX_PAYLOAD > 255
+#error "CAPTURE_SAMPLES_PER_FRAME grande demais para len de 1 byte"
+#endif
+
+typedef struct {
+    uint16_t seq;
+    uint32_t t_us;
+    uint16_t period_us;
+    uint8_t count;
+    int16_t samples[CAPTURE_SAMPLES_PER_FRAME][CAPTURE_AXES];   // ax,ay,az,gx,gy,gz
+} CaptureFrame;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t crc_errors;
+    uint32_t skipped_bytes;   // bytes fora de quadros (texto, lixo, quadros corrompidos)
+} CaptureScanStats;
+
+static inline uint16_t capture_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* ---------- Codificação ---------- */
+
+static inline uint8_t *capture_put_varint(uint8_t *p, int32_t v) {
+    uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);   // zigzag
+    while (z >= 0x80) {
+        *p++ = (uint8_t)(z | 0x80);
+        z >>= 7;
+    }
+    *p++ = (uint8_t)z;
+    return p;
+}
+
+// Escreve o quadro em out (>= CAPTURE_MAX_FRAME bytes); retorna o tamanho
+static inline size_t capture_encode(const CaptureFrame *f, uint8_t *out) {
+    uint8_t *p = out + 3;
+    *p++ = (uint8_t)f->seq;
+    *p++ = (uint8_t)(f->seq >> 8);
+    for (int i = 0; i < 4; i++) *p++ = (uint8_t)(f->t_us >> (8 * i));
+    *p++ = (uint8_t)f->period_us;
+    *p++ = (uint8_t)(f->period_us >> 8);
+    *p++ = f->count;
+
+    for (int a = 0; a < CAPTURE_AXES; a++) {
+        *p++ = (uint8_t)f->samples[0][a];
+        *p++ = (uint8_t)((uint16_t)f->samples[0][a] >> 8);
+    }
+    for (int s = 1; s < f->count; s++) {
+        for (int a = 0; a < CAPTURE_AXES; a++) {
+            p = capture_put_varint(p, (int32_t)f->samples[s][a] - f->samples[s - 1][a]);
+        }
+    }
+
+    size_t len = (size_t)(p - out) - 3;
+    out[0] = CAPTURE_SYNC0;
+    out[1] = CAPTURE_SYNC1;
+    out[2] = (uint8_t)len;
+    uint16_t crc = capture_crc16(out + 2, len + 1);
+    *p++ = (uint8_t)crc;
+    *p++ = (uint8_t)(crc >> 8);
+    return (size_t)(p - out);
+}
+
+/* ---------- Decodificação ---------- */
+
+static inline bool capture_get_varint(const uint8_t **p, const uint8_t *end, int32_t *v) {
+    uint32_t z = 0;
+    for (int shift = 0; shift < 21; shift += 7) {
+        if (*p >= end) return false;
+        uint8_t b = *(*p)++;
+        z |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *v = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool capture_decode_payload(const uint8_t *p, size_t len, CaptureFrame *f) {
+    const uint8_t *end = p + len;
+    f->seq = (uint16_t)(p[0] | p[1] << 8);
+    f->t_us = (uint32_t)p[2] | (uint32_t)p[3] << 8 | (uint32_t)p[4] << 16 | (uint32_t)p[5] << 24;
+    f->period_us = (uint16_t)(p[6] | p[7] << 8);
+    f->count = p[8];
+    if (f->count == 0 || f->count > CAPTURE_SAMPLES_PER_FRAME) return false;
+    p += CAPTURE_HEADER_BYTES;
+
+    for (int a = 0; a < CAPTURE_AXES; a++, p += 2) {
+        f->samples[0][a] = (int16_t)(p[0] | p[1] << 8);
+    }
+    for (int s = 1; s < f->count; s++) {
+        for (int a = 0; a < CAPTURE_AXES; a++) {
+            int32_t d;
+            if (!capture_get_varint(&p, end, &d)) return false;
+            f->samples[s][a] = (int16_t)(f->samples[s - 1][a] + d);
+        }
+    }
+    return p == end;
+}
+
+// Procura o próximo quadro válido em buf[*pos, len). Retorna true e avança
+// *pos para depois do quadro; retorna false quando faltam bytes, com *pos
+// no início do quadro incompleto (ou em len). Bytes que não formam um
+// quadro com CRC válido são pulados, então o fluxo se ressincroniza sozinho.
+static inline bool capture_next_frame(const uint8_t *buf, size_t len, size_t *pos,
+                                      CaptureFrame *f, CaptureScanStats *st) {
+    size_t i = *pos;
+    while (i < len) {
+        if (buf[i] != CAPTURE_SYNC0) {
+            i++;
+            st->skipped_bytes++;
+            continue;
+        }
+        if (len - i < 3) break;
+
+        size_t plen = buf[i + 2];
+        if (buf[i + 1] != CAPTURE_SYNC1 || plen < CAPTURE_MIN_PAYLOAD || plen > CAPTURE_MAX_PAYLOAD) {
+            i++;
+            st->skipped_bytes++;
+            continue;
+        }
+        if (len - i < 3 + plen + 2) break;
+
+        const uint8_t *crc_at = buf + i + 3 + plen;
+        uint16_t crc = (uint16_t)(crc_at[0] | crc_at[1] << 8);
+        if (crc != capture_crc16(buf + i + 2, plen + 1) || !capture_decode_payload(buf + i + 3, plen, f)) {
+            st->crc_errors++;
+            i++;
+            st->skipped_bytes++;
+            continue;
+        }
+
+        *pos = i + 3 + plen + 2;
+        st->frames++;
+        return true;
+    }
+    *pos = i;
+    return false;
+}
+
+#endif
@@ -1,6 +1,20 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "capture_proto.h"
+
+// Modo de saída e taxa (definidos no CMake: COLLECT_BINARY, COLLECT_RATE_HZ)
+#ifndef COLLECT_BINARY
+#define COLLECT_BINARY 0
+#endif
+#ifndef COLLECT_RATE_HZ
+#define COLLECT_RATE_HZ 50
+#endif
+#define COLLECT_PERIOD_US (1000000 / COLLECT_RATE_HZ)
+
+#if COLLECT_BINARY && COLLECT_PERIOD_US > 0xFFFF
+#error "COLLECT_RATE_HZ precisa ser >= 16 no modo binario (period_us tem 16 bits)"
+#endif
 
 // Configurações I2C
 #define I2C_PORT i2c0
@@ -78,6 +92,15 @@ void mpu6500_read_data(int16_t *accel, int16_t *gyro) {
     gyro[2] = (buffer[12] << 8) | buffer[13]; // GZ
 }
 
+#if COLLECT_BINARY
+// Envia bytes crus pelo USB (printf converteria \n em \r\n)
+static void write_raw(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        putchar_raw(data[i]);
+    }
+}
+#endif
+
 int main() {
     // Inicializar USB Serial
     stdio_init_all();
@@ -104,23 +127,53 @@ int main() {
     }
     
     printf("\n=== READY TO COLLECT DATA ===\n");
-    printf("Format: AX,AY,AZ,GX,GY,GZ\n");
+#if COLLECT_BINARY
+    printf("Format: binario (capture_proto.h), %d Hz\n", COLLECT_RATE_HZ);
+#else
+    printf("Format: AX,AY,AZ,GX,GY,GZ (%d Hz)\n", COLLECT_RATE_HZ);
+#endif
     printf("Starting in 3 seconds...\n");
     sleep_ms(3000);
     
     int16_t accel[3];
     int16_t gyro[3];
+
+#if COLLECT_BINARY
+    static CaptureFrame frame;
+    static uint8_t out[CAPTURE_MAX_FRAME];
+    frame.seq = 0;
+    frame.count = 0;
+    frame.period_us = COLLECT_PERIOD_US;
+#endif
     
-    // Loop de coleta (50Hz = 20ms por amostra)
+    // Loop de coleta em instantes absolutos: o tempo de leitura e de envio
+    // não acumula atraso (sleep_ms(20) depois da leitura dava menos de 50 Hz)
+    absolute_time_t next = get_absolute_time();
     while (true) {
+#if COLLECT_BINARY
+        if (frame.count == 0) frame.t_us = time_us_32();
+#endif
         mpu6500_read_data(accel, gyro);
         
+#if COLLECT_BINARY
+        for (int a = 0; a < 3; a++) {
+            frame.samples[frame.count][a] = accel[a];
+            frame.samples[frame.count][3 + a] = gyro[a];
+        }
+        if (++frame.count == CAPTURE_SAMPLES_PER_FRAME) {
+            write_raw(out, capture_encode(&frame, out));
+            frame.seq++;
+            frame.count = 0;
+        }
+#else
         // Imprimir em formato CSV (fácil de salvar e processar)
         printf("%d,%d,%d,%d,%d,%d\n", 
                accel[0], accel[1], accel[2],
                gyro[0], gyro[1], gyro[2]);
+#endif
         
-        sleep_ms(20); // 50Hz de amostragem
+        next = delayed_by_us(next, COLLECT_PERIOD_US);
+        sleep_until(next);
     }
     
     return 0;
@@ -0,0 +1,174 @@
+// Decodifica a saída binária do collect_data (COLLECT_BINARY) e grava o
+// CSV no formato de data/ (ax,ay,az,gx,gy,gz por linha).
+//
+//   capture_decode [-o saida.csv] [-s] [-n amostras] entrada
+//
+// entrada: arquivo gravado, porta serial (/dev/ttyACM0) ou "-" (stdin).
+// Quadros perdidos são detectados pelo número de sequência; com -s cada
+// trecho contínuo vai para um arquivo próprio (saida_1.csv, saida_2.csv...),
+// para que nenhuma janela de treino atravesse uma perda. Ctrl+C encerra a
+// captura e imprime o resumo.
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "capture_proto.h"
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void on_sigint(int) { stop_requested = 1; }
+
+// Porta serial em modo cru (sem eco, sem tradução de fim de linha)
+static void set_raw_tty(int fd) {
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) return;
+    cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+}
+
+class CsvWriter {
+public:
+    CsvWriter(const std::string &path, bool split) : path_(path), split_(split) {}
+    ~CsvWriter() { close(); }
+
+    bool open_next() {
+        close();
+        std::string name = path_;
+        if (split_) {
+            size_t dot = path_.rfind('.');
+            std::string n = "_" + std::to_string(++part_);
+            name = dot == std::string::npos ? path_ + n : path_.substr(0, dot) + n + path_.substr(dot);
+        }
+        fp_ = path_ == "-" ? stdout : fopen(name.c_str(), "w");
+        return fp_ != NULL;
+    }
+
+    void write(const int16_t *s) {
+        fprintf(fp_, "%d,%d,%d,%d,%d,%d\n", s[0], s[1], s[2], s[3], s[4], s[5]);
+    }
+
+    void close() {
+        if (fp_ != NULL && fp_ != stdout) fclose(fp_);
+        fp_ = NULL;
+    }
+
+    int parts() const { return part_; }
+
+private:
+    std::string path_;
+    bool split_;
+    int part_ = 0;
+    FILE *fp_ = NULL;
+};
+
+int main(int argc, char **argv) {
+    std::string out_path = "captura.csv";
+    const char *in_path = NULL;
+    bool split = false;
+    long max_samples = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) max_samples = atol(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0) split = true;
+        else in_path = argv[i];
+    }
+    if (in_path == NULL) {
+        fprintf(stderr, "uso: capture_decode [-o saida.csv] [-s] [-n amostras] entrada\n");
+        return 2;
+    }
+
+    int fd = strcmp(in_path, "-") == 0 ? STDIN_FILENO : open(in_path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "nao foi possivel abrir %s\n", in_path);
+        return 2;
+    }
+    if (isatty(fd)) set_raw_tty(fd);
+    signal(SIGINT, on_sigint);
+
+    CsvWriter csv(out_path, split);
+    if (!csv.open_next()) {
+        fprintf(stderr, "nao foi possivel criar %s\n", out_path.c_str());
+        return 2;
+    }
+
+    /* ---------- Leitura e decodificação ---------- */
+    std::vector<uint8_t> buf;
+    size_t pos = 0;
+    CaptureScanStats st = {0, 0, 0};
+    CaptureFrame f;
+
+    bool have_last = false;
+    uint16_t last_seq = 0, period_us = 0;
+    uint32_t next_t = 0, first_t = 0;
+    long samples = 0, lost_frames = 0, lost_samples = 0, gaps = 0, restarts = 0;
+    int32_t worst_slip = 0;
+
+    uint8_t chunk[4096];
+    while (!stop_requested && (max_samples == 0 || samples < max_samples)) {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) break;
+
+        // Descarta o que já foi consumido antes de acrescentar
+        buf.erase(buf.begin(), buf.begin() + pos);
+        pos = 0;
+        buf.insert(buf.end(), chunk, chunk + n);
+
+        while (capture_next_frame(buf.data(), buf.size(), &pos, &f, &st)) {
+            if (have_last) {
+                uint16_t missing = (uint16_t)(f.seq - last_seq - 1);
+                if (missing >= 0x8000) {
+                    // seq voltou atrás: o Pico reiniciou
+                    restarts++;
+                    gaps++;
+                    if (split) csv.open_next();
+                } else if (missing > 0) {
+                    lost_frames += missing;
+                    lost_samples += (long)missing * CAPTURE_SAMPLES_PER_FRAME;
+                    gaps++;
+                    if (split) csv.open_next();
+                } else {
+                    int32_t slip = (int32_t)(f.t_us - next_t);
+                    if (abs(slip) > abs(worst_slip)) worst_slip = slip;
+                }
+            } else {
+                first_t = f.t_us;
+            }
+            have_last = true;
+            last_seq = f.seq;
+            period_us = f.period_us;
+            next_t = f.t_us + (uint32_t)f.count * f.period_us;
+
+            for (int s = 0; s < f.count && (max_samples == 0 || samples < max_samples); s++) {
+                csv.write(f.samples[s]);
+                samples++;
+            }
+        }
+    }
+    st.skipped_bytes += (uint32_t)(buf.size() - pos);
+    if (fd != STDIN_FILENO) close(fd);
+    csv.close();
+
+    /* ---------- Resumo ---------- */
+    fprintf(stderr, "quadros: %u | amostras: %ld", st.frames, samples);
+    if (have_last && period_us > 0) {
+        double secs = (uint32_t)(next_t - first_t) / 1e6;
+        fprintf(stderr, " | taxa nominal %.1f Hz | duracao %.2f s", 1e6 / period_us, secs);
+    }
+    fprintf(stderr, "\nquadros perdidos: %ld (%ld amostras, %ld trechos)", lost_frames, lost_samples, gaps);
+    if (restarts > 0) fprintf(stderr, " | reinicios do Pico: %ld", restarts);
+    fprintf(stderr, "\nerros de CRC: %u | bytes ignorados: %u | maior desvio de timestamp: %d us\n",
+            st.crc_errors, st.skipped_bytes, worst_slip);
+    if (split) fprintf(stderr, "arquivos: %d\n", csv.parts());
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Confere capture_proto.h sem hardware: codifica data/*.csv em quadros,
+// intercala texto (como as mensagens de boot), perde e corrompe quadros, e
+// verifica que o decodificador recupera todas as amostras dos quadros
+// íntegros, na ordem, e aponta exatamente as perdas.
+//
+//   capture_proto_check [arquivo.csv ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "capture_proto.h"
+
+#define PERIOD_US 1000   // 1 kHz
+
+typedef struct {
+    int16_t (*rows)[CAPTURE_AXES];
+    size_t count;
+} Rows;
+
+static bool load_csv(const char *path, Rows *r) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) return false;
+    size_t cap = 1024;
+    r->rows = malloc(cap * sizeof(*r->rows));
+    r->count = 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int v[6];
+        if (sscanf(line, "%d,%d,%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) continue;
+        if (r->count == cap) {
+            cap *= 2;
+            r->rows = realloc(r->rows, cap * sizeof(*r->rows));
+        }
+        for (int a = 0; a < CAPTURE_AXES; a++) r->rows[r->count][a] = (int16_t)v[a];
+        r->count++;
+    }
+    fclose(fp);
+    return true;
+}
+
+// Um arquivo: retorna o número de falhas
+static int check_file(const char *path) {
+    Rows r;
+    if (!load_csv(path, &r)) {
+        fprintf(stderr, "nao foi possivel abrir %s\n", path);
+        return 1;
+    }
+
+    size_t num_frames = (r.count + CAPTURE_SAMPLES_PER_FRAME - 1) / CAPTURE_SAMPLES_PER_FRAME;
+    uint8_t *stream = malloc(num_frames * (CAPTURE_MAX_FRAME + 16) + 64);
+    bool *sent = calloc(num_frames, sizeof(bool));
+    size_t len = 0, csv_bytes = 0;
+    int dropped = 0, corrupted = 0;
+
+    const char *boot = "\n=== READY TO COLLECT DATA ===\nFormat: binario\n";
+    memcpy(stream, boot, strlen(boot));
+    len = strlen(boot);
+
+    /* ---------- Codificação com falhas ---------- */
+    for (size_t k = 0; k < num_frames; k++) {
+        CaptureFrame f;
+        size_t first = k * CAPTURE_SAMPLES_PER_FRAME;
+        f.seq = (uint16_t)k;
+        f.t_us = (uint32_t)(0xFFFF0000u + first * PERIOD_US);   // atravessa o estouro de 32 bits
+        f.period_us = PERIOD_US;
+        f.count = (uint8_t)(r.count - first < CAPTURE_SAMPLES_PER_FRAME ? r.count - first : CAPTURE_SAMPLES_PER_FRAME);
+        memcpy(f.samples, r.rows[first], f.count * sizeof(r.rows[0]));
+
+        uint8_t frame[CAPTURE_MAX_FRAME];
+        size_t n = capture_encode(&f, frame);
+        for (int s = 0; s < f.count; s++) {
+            const int16_t *v = f.samples[s];
+            csv_bytes += (size_t)snprintf(NULL, 0, "%d,%d,%d,%d,%d,%d\n", v[0], v[1], v[2], v[3], v[4], v[5]);
+        }
+
+        if (k % 37 == 5) {   // perdido no USB
+            dropped++;
+            continue;
+        }
+        if (k % 53 == 11) {  // um bit trocado
+            frame[3 + (k % (n - 5))] ^= 0x10;
+            corrupted++;
+        } else {
+            sent[k] = true;
+        }
+        memcpy(stream + len, frame, n);
+        len += n;
+        if (k % 41 == 7) {   // lixo entre quadros, com bytes de sincronismo
+            const uint8_t junk[] = { CAPTURE_SYNC0, CAPTURE_SYNC1, 200, 'o', 'k', '\n' };
+            memcpy(stream + len, junk, sizeof(junk));
+            len += sizeof(junk);
+        }
+    }
+
+    /* ---------- Decodificação em pedaços pequenos ---------- */
+    CaptureScanStats st = {0, 0, 0};
+    CaptureFrame f;
+    size_t pos = 0, avail = 0, expected_frame = 0;
+    int failures = 0, lost = 0;
+    bool first = true;
+    uint16_t last_seq = 0;
+
+    while (avail < len) {
+        avail = avail + 7 < len ? avail + 7 : len;
+        while (capture_next_frame(stream, avail, &pos, &f, &st)) {
+            if (!first) lost += (uint16_t)(f.seq - last_seq - 1);
+            first = false;
+            last_seq = f.seq;
+
+            while (expected_frame < num_frames && !sent[expected_frame]) expected_frame++;
+            size_t base = f.seq * CAPTURE_SAMPLES_PER_FRAME;
+            if (f.seq != expected_frame || f.period_us != PERIOD_US ||
+                f.t_us != (uint32_t)(0xFFFF0000u + base * PERIOD_US) ||
+                memcmp(f.samples, r.rows[base], f.count * sizeof(r.rows[0])) != 0) {
+                if (failures++ < 5) printf("%s: quadro %u difere (esperado %zu)\n", path, f.seq, expected_frame);
+            }
+            expected_frame++;
+        }
+    }
+    while (expected_frame < num_frames && !sent[expected_frame]) expected_frame++;
+
+    if (expected_frame != num_frames) {
+        printf("%s: faltaram quadros (parou em %zu de %zu)\n", path, expected_frame, num_frames);
+        failures++;
+    }
+    if (lost != dropped + corrupted) {
+        printf("%s: perdas detectadas %d, esperado %d\n", path, lost, dropped + corrupted);
+        failures++;
+    }
+    if (st.crc_errors != (uint32_t)corrupted) {
+        printf("%s: erros de CRC %u, esperado %d\n", path, st.crc_errors, corrupted);
+        failures++;
+    }
+
+    printf("%-40s %4u quadros | perdidos %d + corrompidos %d | bytes/amostra: %.2f (CSV %.2f)\n",
+           path, st.frames, dropped, corrupted, (double)len / r.count, (double)csv_bytes / r.count);
+
+    free(sent);
+    free(stream);
+    free(r.rows);
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {
+        DATA_DIR "/parado.csv", DATA_DIR "/caminhando.csv",
+        DATA_DIR "/correndo.csv", DATA_DIR "/pulando.csv"
+    };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int num_files = argc > 1 ? argc - 1 : 4;
+
+    int failures = 0;
+    for (int k = 0; k < num_files; k++) failures += check_file(files[k]);
+
+    printf(failures == 0 ? "OK\n" : "FALHOU\n");
+    return failures == 0 ? 0 : 1;
+}
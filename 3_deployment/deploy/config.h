@@ -7,10 +7,95 @@
 #define I2C_SCL 1
 #define MPU6500_ADDR 0x68
 
+// Leitura em rajadas pelo FIFO do MPU6500 (taxa = 1 kHz / (1 + DIV))
+#ifndef MPU6500_USE_FIFO
+#define MPU6500_USE_FIFO 0
+#endif
+#define MPU6500_SAMPLE_RATE_DIV (SENSOR_INTERVAL_US / 1000 - 1)
+#define MPU6500_FIFO_BATCH 10   // amostras drenadas por rajada
+
 // Modelo e Amostragem
+#ifndef WINDOW_SIZE
 #define WINDOW_SIZE 20
-#define SAMPLE_INTERVAL_MS 50
+#endif
+#define WINDOW_HOP 10   // amostras entre inferências (STRIDE do treino)
+#define SAMPLE_INTERVAL_MS 50   // taxa das amostras que entram na janela
 #define NUM_FEATURES 14
+
+// Decimação antes da janela: o sensor roda a DECIM_INPUT_RATE_HZ e um CIC
+// (DECIM_CIC_RATIO, ordem DECIM_CIC_ORDER) + FIR de compensação que decima
+// por DECIM_FIR_RATIO entrega SAMPLE_INTERVAL_MS filtrado contra aliasing.
+// Os coeficientes vêm de decimator_coeffs.h (host/tools/gen_decimator.py).
+#ifndef DECIMATOR_ENABLE
+#define DECIMATOR_ENABLE 0
+#endif
+#define DECIM_INPUT_RATE_HZ 1000
+#define DECIM_FIR_RATIO 2
+#define DECIM_CIC_RATIO (DECIM_INPUT_RATE_HZ * SAMPLE_INTERVAL_MS / 1000 / DECIM_FIR_RATIO)
+#define DECIM_CIC_ORDER 3
+
+// Período de leitura do sensor
+#if DECIMATOR_ENABLE
+#define SENSOR_INTERVAL_US (1000000 / DECIM_INPUT_RATE_HZ)
+#else
+#define SENSOR_INTERVAL_US (SAMPLE_INTERVAL_MS * 1000)
+#endif
 #define NUM_CLASSES 4
 
+// Gate de movimento antes do modelo: janelas com a soma dos desvios padrão
+// do accel e do gyro (Q8, LSB * 256) abaixo dos limiares viram "parado" sem
+// rodar a inferência. Limiares calibrados com host/build/batch_eval -s 1 -g
+// no trecho inicial de data/*.csv (MOTION_GATE_MARGIN_PCT do menor valor
+// visto em movimento).
+#ifndef MOTION_GATE_ENABLE
+#define MOTION_GATE_ENABLE 0
+#endif
+#define MOTION_GATE_ACCEL_STD_Q8 114237   // ~446 LSB
+#define MOTION_GATE_GYRO_STD_Q8 310025    // ~1211 LSB
+#define MOTION_GATE_MARGIN_PCT 50
+
+// Classificação antecipada: depois do boot, resultados provisórios com a
+// janela parcial a partir de ANYTIME_MIN_SAMPLES amostras e a cada
+// ANYTIME_STEP até encher. Um provisório com confiança >= ANYTIME_CONFIDENCE
+// (décimos de %) encerra os disparos até a primeira janela cheia. Valores
+// escolhidos com host/build/anytime_eval sobre data/*.csv.
+#ifndef ANYTIME_ENABLE
+#define ANYTIME_ENABLE 0
+#endif
+#define ANYTIME_MIN_SAMPLES 8
+#define ANYTIME_STEP 4
+#define ANYTIME_CONFIDENCE 900
+
+// Features espectrais (include/spectral.h): FFT real em ponto fixo da
+// magnitude do accel nas últimas SPECTRAL_FFT_SIZE amostras (potência de 2),
+// com frequência dominante (cadência), energia por banda e entropia. As
+// bordas das bandas são em décimos de Hz; a última vai até Nyquist.
+#ifndef SPECTRAL_ENABLE
+#define SPECTRAL_ENABLE 0
+#endif
+#ifndef SPECTRAL_FFT_SIZE
+#define SPECTRAL_FFT_SIZE 64   // 3,2 s a 20 Hz, 0,31 Hz por bin
+#endif
+#define SPECTRAL_BANDS 4
+#define SPECTRAL_BAND_EDGES_DHZ { 5, 15, 25, 35 }   // início de cada banda
+#define SPECTRAL_NUM_FEATURES (SPECTRAL_BANDS + 2)
+
+// Arena do TFLM; ajuste pelo valor medido que ai_init reporta
+// (ai_arena_used_bytes) com -DAI_TENSOR_ARENA_SIZE=<bytes>
+#ifndef AI_TENSOR_ARENA_SIZE
+#define AI_TENSOR_ARENA_SIZE (12 * 1024)
+#endif
+
+// Profiler por estágio (include/profiler.h): tabela mín/p50/p99/máx pelo
+// console serial; desligado, as medições não são compiladas
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE 0
+#endif
+
+// Pipeline em dois cores: core 1 amostra, core 0 processa
+#ifndef PIPELINE_DUAL_CORE
+#define PIPELINE_DUAL_CORE 0
+#endif
+#define SAMPLE_RING_SIZE 32   // potência de 2
+
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,29 @@
+// Gerado por host/tools/gen_decimator.py - nao editar.
+// CIC 25 x ordem 3 + FIR de compensacao 31 taps / 2: 1000 Hz -> 20 Hz,
+// banda passante 6 Hz.
+
+#ifndef DECIMATOR_COEFFS_H
+#define DECIMATOR_COEFFS_H
+
+#include <stdint.h>
+
+#define DECIM_GEN_INPUT_RATE_HZ 1000
+#define DECIM_GEN_CIC_RATIO 25
+#define DECIM_GEN_CIC_ORDER 3
+#define DECIM_GEN_FIR_RATIO 2
+#define DECIM_FIR_TAPS 31
+#define DECIM_PASSBAND_HZ 6
+
+// Ganho do CIC (R^N = 15625) compensado por (x * MULT) >> SHIFT
+#define DECIM_CIC_NORM_MULT 1125899907
+#define DECIM_CIC_NORM_SHIFT 44
+
+// Q15, simétricos, soma 32768
+static const int16_t decim_fir_coeffs[DECIM_FIR_TAPS] = {
+    -1, 1, 3, 1, 9, -9, -46, 3,
+    -15, 49, 623, -86, -2768, -513, 10387, 17492,
+    10387, -513, -2768, -86, 623, 49, -15, 3,
+    -46, -9, 9, 1, 3, 1, -1,
+};
+
+#endif
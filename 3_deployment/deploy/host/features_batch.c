@@ -0,0 +1,96 @@
+#include "features_batch.h"
+#include "include/feature_math.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FEATURES_BATCH_X86 1
+#else
+#define FEATURES_BATCH_X86 0
+#endif
+
+static const char *isa_names[FEATURE_ISA_COUNT] = { "escalar", "sse4.1", "avx2" };
+
+/* ---------- Escalar (fallback e cauda dos kernels SIMD) ---------- */
+
+// Contas de include/feature_math.h, como src/features.c, mas sobre a janela
+// inteira em vez do estado incremental; é também a referência dos kernels SIMD
+static void extract_one(const FeatureBatch *b, size_t w, float *f) {
+    const int n = b->length;
+    const size_t stride = b->stride;
+    const size_t ch_step = (size_t)n * stride;
+    const int16_t *base = b->data + w;
+
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        const int16_t *p = base + ch * ch_step;
+        int32_t s = 0, mx = INT16_MIN, mn = INT16_MAX;
+        int64_t sum_sq = 0;
+        for (int t = 0; t < n; t++) {
+            int32_t v = p[(size_t)t * stride];
+            s += v;
+            sum_sq += v * v;
+            if (v > mx) mx = v;
+            if (v < mn) mn = v;
+        }
+        f[ch] = feat_std((float)feat_var_n2(n, s, sum_sq), n);
+
+        if (ch < RANGE_CHANNELS) {
+            int prev = feat_sign(p[0], n, s);
+            f[8 + ch] = feat_range(mx, mn);
+            f[11 + ch] = feat_zcr(feat_sign_steps(p, stride, n, n, s, &prev));
+        }
+    }
+
+    for (int k = 0; k < 2; k++) {
+        const int16_t *p = base + (k ? CH_GX : CH_AX) * ch_step;
+        uint64_t sum_mag = 0;
+        for (int t = 0; t < n; t++) {
+            const int16_t *q = p + (size_t)t * stride;
+            sum_mag += feat_mag_q8(q[0], q[ch_step], q[2 * ch_step]);
+        }
+        f[6 + k] = feat_mean_mag(sum_mag, n);
+    }
+}
+
+/* ---------- Seleção da ISA ---------- */
+
+bool features_batch_isa_supported(FeatureIsa isa) {
+    switch (isa) {
+    case FEATURE_ISA_SCALAR:
+        return true;
+#if FEATURES_BATCH_X86
+    case FEATURE_ISA_SSE41:
+        return __builtin_cpu_supports("sse4.1");
+    case FEATURE_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+FeatureIsa features_batch_best_isa(void) {
+    for (int isa = FEATURE_ISA_COUNT - 1; isa > FEATURE_ISA_SCALAR; isa--) {
+        if (features_batch_isa_supported((FeatureIsa)isa)) return (FeatureIsa)isa;
+    }
+    return FEATURE_ISA_SCALAR;
+}
+
+const char *features_batch_isa_name(FeatureIsa isa) {
+    return (unsigned)isa < FEATURE_ISA_COUNT ? isa_names[isa] : "?";
+}
+
+bool features_batch_extract(const FeatureBatch *b, FeatureIsa isa, float *out) {
+    if (!features_batch_isa_supported(isa) || b->length < 1 || b->length > 512) return false;
+
+    size_t done = 0;
+#if FEATURES_BATCH_X86
+    if (isa == FEATURE_ISA_AVX2) {
+        done = b->count / 8 * 8;
+        features_batch_avx2(b, 0, done / 8, out);
+    } else if (isa == FEATURE_ISA_SSE41) {
+        done = b->count / 4 * 4;
+        features_batch_sse41(b, 0, done / 4, out);
+    }
+#endif
+    for (size_t w = done; w < b->count; w++) extract_one(b, w, out + w * NUM_FEATURES);
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef FEATURES_BATCH_H
+#define FEATURES_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "include/features.h"
+
+// Extração das 14 features de muitas janelas de uma vez (somente host),
+// para montar datasets e avaliar offline. As janelas vêm em struct-of-arrays
+// e cada lane do SIMD processa uma janela. O resultado é bit a bit igual ao
+// caminho float de extract_features (FEATURES_FIXED_POINT=0): as somas são
+// exatas (inteiros ou double) e as operações float são as mesmas, na mesma
+// ordem.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lote: a amostra t do canal ch da janela w fica em
+// data[((size_t)ch * length + t) * stride + w]
+typedef struct {
+    const int16_t *data;
+    size_t count;    // janelas válidas
+    size_t stride;   // janelas por linha (>= count; múltiplo de 8 evita cauda)
+    int length;      // amostras por janela (1..512)
+} FeatureBatch;
+
+typedef enum {
+    FEATURE_ISA_SCALAR,
+    FEATURE_ISA_SSE41,
+    FEATURE_ISA_AVX2,
+    FEATURE_ISA_COUNT
+} FeatureIsa;
+
+// Melhor conjunto de instruções suportado pela CPU e pelo build
+FeatureIsa features_batch_best_isa(void);
+bool features_batch_isa_supported(FeatureIsa isa);
+const char *features_batch_isa_name(FeatureIsa isa);
+
+// out: [count][NUM_FEATURES], na ordem de extract_features.
+// Retorna false se a ISA não for suportada.
+bool features_batch_extract(const FeatureBatch *b, FeatureIsa isa, float *out);
+
+// Kernels por ISA (features_batch_sse41.c, features_batch_avx2.c): processam
+// groups grupos de 4 (SSE4.1) ou 8 (AVX2) janelas a partir da janela first;
+// out aponta para a linha da janela first
+void features_batch_sse41(const FeatureBatch *b, size_t first, size_t groups, float *out);
+void features_batch_avx2(const FeatureBatch *b, size_t first, size_t groups, float *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
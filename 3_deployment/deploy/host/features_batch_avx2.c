@@ -0,0 +1,43 @@
+// Kernel AVX2 de features_batch: 8 janelas por iteração.
+// Compilado com -mavx2 (só este arquivo); chamado após checar a CPU.
+
+#include <immintrin.h>
+#include "features_batch.h"
+
+#define FB_KERNEL features_batch_avx2
+#define FB_LANES 8
+
+typedef __m256i fb_vi;
+typedef __m256d fb_vd;
+typedef __m256 fb_vf;
+
+#define FB_LOAD16(p) _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(p)))
+#define FB_SET1_I(v) _mm256_set1_epi32(v)
+#define FB_ADD_I(a, b) _mm256_add_epi32(a, b)
+#define FB_SUB_I(a, b) _mm256_sub_epi32(a, b)
+#define FB_MUL_I(a, b) _mm256_mullo_epi32(a, b)
+#define FB_MAX_I(a, b) _mm256_max_epi32(a, b)
+#define FB_MIN_I(a, b) _mm256_min_epi32(a, b)
+#define FB_CMPGT_I(a, b) _mm256_cmpgt_epi32(a, b)
+#define FB_XOR_I(a, b) _mm256_xor_si256(a, b)
+#define FB_STORE_I(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+
+#define FB_LO_D(v) _mm256_cvtepi32_pd(_mm256_castsi256_si128(v))
+#define FB_HI_D(v) _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1))
+#define FB_SET1_D(v) _mm256_set1_pd(v)
+#define FB_ADD_D(a, b) _mm256_add_pd(a, b)
+#define FB_SUB_D(a, b) _mm256_sub_pd(a, b)
+#define FB_MUL_D(a, b) _mm256_mul_pd(a, b)
+
+#define FB_D_TO_F(lo, hi) \
+    _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1)
+#define FB_I_TO_F(v) _mm256_cvtepi32_ps(v)
+#define FB_F_TO_I_TRUNC(v) _mm256_cvttps_epi32(v)
+#define FB_SET1_F(v) _mm256_set1_ps(v)
+#define FB_ADD_F(a, b) _mm256_add_ps(a, b)
+#define FB_MUL_F(a, b) _mm256_mul_ps(a, b)
+#define FB_DIV_F(a, b) _mm256_div_ps(a, b)
+#define FB_SQRT_F(v) _mm256_sqrt_ps(v)
+#define FB_STORE_F(p, v) _mm256_storeu_ps(p, v)
+
+#include "features_batch_kernel.h"
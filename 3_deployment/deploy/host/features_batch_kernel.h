@@ -0,0 +1,125 @@
+// Corpo comum dos kernels SIMD de features_batch (sem include guard: é
+// incluído uma vez por ISA). Quem inclui define FB_KERNEL, FB_LANES, os tipos
+// fb_vi (int32), fb_vd (double, FB_LANES/2) e fb_vf (float) e as operações
+// abaixo. Cada lane é uma janela.
+//
+// Aqui ficam só as lanes: somas, extremos e passos de sinal de cada janela.
+// Range e ZCR saem por lane das mesmas funções de include/feature_math.h que
+// extract_one usa; desvio e magnitude refazem feat_std/feat_mag_q8 em vetor.
+//
+// Exatidão em relação a extract_one (caminho float):
+//  - soma e mín/máx em int32; x*n cabe em 32 bits (|x| <= 32768, n <= 512)
+//  - somas dos quadrados e das magnitudes em double: são inteiros < 2^53,
+//    então ficam exatas, e a conversão para float arredonda uma vez só, como
+//    (float)int64 no escalar
+//  - sqrt, divisão e *256 + 0.5 em float, como sqrtf e os operadores em C
+
+#include "include/feature_math.h"
+
+static inline void fb_store_lanes(float dst[FB_LANES], fb_vf v) {
+    FB_STORE_F(dst, v);
+}
+
+// Extremos e passos de sinal de um canal, por lane
+typedef struct {
+    int32_t mx[FB_LANES], mn[FB_LANES], steps[FB_LANES];
+} FbRange;
+
+// Desvio padrão de um canal e, com range != NULL, extremos e passos de sinal
+static inline fb_vf fb_channel(const int16_t *p, size_t stride, int length, FbRange *range) {
+    const fb_vi n = FB_SET1_I(length);
+    fb_vi sum = FB_SET1_I(0);
+    fb_vi mx = FB_SET1_I(INT16_MIN), mn = FB_SET1_I(INT16_MAX);
+    fb_vd sq_lo = FB_SET1_D(0.0), sq_hi = FB_SET1_D(0.0);
+
+    for (int t = 0; t < length; t++) {
+        fb_vi v = FB_LOAD16(p + (size_t)t * stride);
+        fb_vi sq = FB_MUL_I(v, v);
+        sum = FB_ADD_I(sum, v);
+        sq_lo = FB_ADD_D(sq_lo, FB_LO_D(sq));
+        sq_hi = FB_ADD_D(sq_hi, FB_HI_D(sq));
+        mx = FB_MAX_I(mx, v);
+        mn = FB_MIN_I(mn, v);
+    }
+
+    // variância * n² = n * soma_sq - soma², exata em double
+    const fb_vd nd = FB_SET1_D((double)length);
+    fb_vd s_lo = FB_LO_D(sum), s_hi = FB_HI_D(sum);
+    fb_vd var_lo = FB_SUB_D(FB_MUL_D(nd, sq_lo), FB_MUL_D(s_lo, s_lo));
+    fb_vd var_hi = FB_SUB_D(FB_MUL_D(nd, sq_hi), FB_MUL_D(s_hi, s_hi));
+    fb_vf std = FB_DIV_F(FB_SQRT_F(FB_D_TO_F(var_lo, var_hi)), FB_SET1_F((float)length));
+
+    if (range) {
+        FB_STORE_I(range->mx, mx);
+        FB_STORE_I(range->mn, mn);
+
+        // feat_sign = [x * n > soma] - [x * n < soma]; as duas máscaras (-1
+        // onde é verdade) nunca valem juntas, então |Δsign| é a soma das
+        // trocas de cada uma e a conta fica igual a feat_sign_steps
+        fb_vi xn = FB_MUL_I(FB_LOAD16(p), n);
+        fb_vi prev_gt = FB_CMPGT_I(xn, sum), prev_lt = FB_CMPGT_I(sum, xn);
+        fb_vi steps = FB_SET1_I(0);
+        for (int t = 1; t < length; t++) {
+            xn = FB_MUL_I(FB_LOAD16(p + (size_t)t * stride), n);
+            fb_vi gt = FB_CMPGT_I(xn, sum), lt = FB_CMPGT_I(sum, xn);
+            steps = FB_SUB_I(steps, FB_XOR_I(gt, prev_gt));
+            steps = FB_SUB_I(steps, FB_XOR_I(lt, prev_lt));
+            prev_gt = gt;
+            prev_lt = lt;
+        }
+        FB_STORE_I(range->steps, steps);
+    }
+    return std;
+}
+
+// Magnitude média dos três canais a partir de p (accel ou gyro), em Q8
+// amostra a amostra como feat_mag_q8
+static inline fb_vf fb_mean_magnitude(const int16_t *p, size_t stride, int length) {
+    const size_t ch_step = (size_t)length * stride;
+    fb_vd acc_lo = FB_SET1_D(0.0), acc_hi = FB_SET1_D(0.0);
+
+    for (int t = 0; t < length; t++) {
+        const int16_t *s = p + (size_t)t * stride;
+        fb_vi x = FB_LOAD16(s), y = FB_LOAD16(s + ch_step), z = FB_LOAD16(s + 2 * ch_step);
+        fb_vi xx = FB_MUL_I(x, x), yy = FB_MUL_I(y, y), zz = FB_MUL_I(z, z);
+        // x² + y² + z² passa de 2^31: soma em double (exata)
+        fb_vd lo = FB_ADD_D(FB_ADD_D(FB_LO_D(xx), FB_LO_D(yy)), FB_LO_D(zz));
+        fb_vd hi = FB_ADD_D(FB_ADD_D(FB_HI_D(xx), FB_HI_D(yy)), FB_HI_D(zz));
+        fb_vf r = FB_SQRT_F(FB_D_TO_F(lo, hi));
+        fb_vi q8 = FB_F_TO_I_TRUNC(FB_ADD_F(FB_MUL_F(r, FB_SET1_F((float)(1 << MAG_FRAC_BITS))),
+                                            FB_SET1_F(0.5f)));
+        acc_lo = FB_ADD_D(acc_lo, FB_LO_D(q8));
+        acc_hi = FB_ADD_D(acc_hi, FB_HI_D(q8));
+    }
+    return FB_DIV_F(FB_D_TO_F(acc_lo, acc_hi), FB_SET1_F((float)(length << MAG_FRAC_BITS)));
+}
+
+void FB_KERNEL(const FeatureBatch *b, size_t first, size_t groups, float *out) {
+    const size_t stride = b->stride;
+    const size_t ch_step = (size_t)b->length * stride;
+
+    for (size_t g = 0; g < groups; g++) {
+        const int16_t *base = b->data + first + g * FB_LANES;
+        float res[NUM_FEATURES][FB_LANES];
+        FbRange range;
+
+        for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+            bool with_range = ch < RANGE_CHANNELS;
+            fb_vf std = fb_channel(base + ch * ch_step, stride, b->length, with_range ? &range : NULL);
+            fb_store_lanes(res[ch], std);
+            if (with_range) {
+                for (int lane = 0; lane < FB_LANES; lane++) {
+                    res[8 + ch][lane] = feat_range(range.mx[lane], range.mn[lane]);
+                    res[11 + ch][lane] = feat_zcr(range.steps[lane]);
+                }
+            }
+        }
+        fb_store_lanes(res[6], fb_mean_magnitude(base + CH_AX * ch_step, stride, b->length));
+        fb_store_lanes(res[7], fb_mean_magnitude(base + CH_GX * ch_step, stride, b->length));
+
+        float *dst = out + g * FB_LANES * NUM_FEATURES;
+        for (int lane = 0; lane < FB_LANES; lane++) {
+            for (int i = 0; i < NUM_FEATURES; i++) dst[lane * NUM_FEATURES + i] = res[i][lane];
+        }
+    }
+}
@@ -0,0 +1,42 @@
+// Kernel SSE4.1 de features_batch: 4 janelas por iteração.
+// Compilado com -msse4.1 (só este arquivo); chamado após checar a CPU.
+
+#include <smmintrin.h>
+#include "features_batch.h"
+
+#define FB_KERNEL features_batch_sse41
+#define FB_LANES 4
+
+typedef __m128i fb_vi;
+typedef __m128d fb_vd;
+typedef __m128 fb_vf;
+
+#define FB_LOAD16(p) _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(p)))
+#define FB_SET1_I(v) _mm_set1_epi32(v)
+#define FB_ADD_I(a, b) _mm_add_epi32(a, b)
+#define FB_SUB_I(a, b) _mm_sub_epi32(a, b)
+#define FB_MUL_I(a, b) _mm_mullo_epi32(a, b)
+#define FB_MAX_I(a, b) _mm_max_epi32(a, b)
+#define FB_MIN_I(a, b) _mm_min_epi32(a, b)
+#define FB_CMPGT_I(a, b) _mm_cmpgt_epi32(a, b)
+#define FB_XOR_I(a, b) _mm_xor_si128(a, b)
+#define FB_STORE_I(p, v) _mm_storeu_si128((__m128i *)(p), v)
+
+#define FB_LO_D(v) _mm_cvtepi32_pd(v)
+#define FB_HI_D(v) _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2)))
+#define FB_SET1_D(v) _mm_set1_pd(v)
+#define FB_ADD_D(a, b) _mm_add_pd(a, b)
+#define FB_SUB_D(a, b) _mm_sub_pd(a, b)
+#define FB_MUL_D(a, b) _mm_mul_pd(a, b)
+
+#define FB_D_TO_F(lo, hi) _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi))
+#define FB_I_TO_F(v) _mm_cvtepi32_ps(v)
+#define FB_F_TO_I_TRUNC(v) _mm_cvttps_epi32(v)
+#define FB_SET1_F(v) _mm_set1_ps(v)
+#define FB_ADD_F(a, b) _mm_add_ps(a, b)
+#define FB_MUL_F(a, b) _mm_mul_ps(a, b)
+#define FB_DIV_F(a, b) _mm_div_ps(a, b)
+#define FB_SQRT_F(v) _mm_sqrt_ps(v)
+#define FB_STORE_F(p, v) _mm_storeu_ps(p, v)
+
+#include "features_batch_kernel.h"
@@ -0,0 +1,211 @@
+#define _POSIX_C_SOURCE 200809L
+#include "include/hal.h"
+#include "include/profiler.h"
+#include "config.h"
+#include "sim_clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// HAL do host: relógio virtual + reprodução dos CSVs gravados.
+// A lista de arquivos vem de DEPLOY_REPLAY (separados por ':'),
+// senão usa os quatro CSVs de DEPLOY_DATA_DIR. DEPLOY_TIMER_LATENCY_US
+// define a latência máxima simulada do timer de amostragem. Os estágios
+// são medidos em tempo real pelo profiler (include/profiler.h).
+// Os CSVs têm uma linha a cada SAMPLE_INTERVAL_MS; com o sensor mais rápido
+// (DECIMATOR_ENABLE) as leituras são interpoladas linearmente entre linhas.
+
+#define MAX_REPLAY_FILES 32
+#define REPLAY_UPSAMPLE (SAMPLE_INTERVAL_MS * 1000 / SENSOR_INTERVAL_US)
+
+static char *replay_files[MAX_REPLAY_FILES];
+static int num_files = 0;
+static int current_file = -1;
+static FILE *replay = NULL;
+
+static int16_t next_row[6];
+static bool has_next = false;
+static int16_t cur_row[6];
+static int upsample_phase = 0;
+
+static uint64_t wakeups = 0;
+static uint32_t timer_latency_us = 0;
+static uint64_t samples_read = 0;
+static uint64_t wall_start_ns = 0;
+
+static uint64_t wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Lê a próxima linha válida, avançando para o próximo arquivo quando preciso
+static void fetch_next_row(void) {
+    char line[256];
+    has_next = false;
+
+    while (true) {
+        if (replay == NULL) {
+            if (current_file + 1 >= num_files) return;
+            current_file++;
+            replay = fopen(replay_files[current_file], "r");
+            if (replay == NULL) {
+                fprintf(stderr, "[host] nao foi possivel abrir %s\n", replay_files[current_file]);
+                continue;
+            }
+            fprintf(stderr, "[host] reproduzindo %s\n", replay_files[current_file]);
+        }
+
+        if (fgets(line, sizeof(line), replay) == NULL) {
+            fclose(replay);
+            replay = NULL;
+            continue;
+        }
+
+        int v[6];
+        if (sscanf(line, "%d,%d,%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == 6) {
+            for (int i = 0; i < 6; i++) next_row[i] = (int16_t)v[i];
+            has_next = true;
+            return;
+        }
+    }
+}
+
+static void add_replay_file(const char *path) {
+    if (num_files < MAX_REPLAY_FILES) {
+        replay_files[num_files++] = strdup(path);
+    }
+}
+
+static void print_report(void) {
+    uint64_t wall = wall_ns() - wall_start_ns;
+
+    uint64_t virtual_us = sim_clock_now_us();
+
+    fprintf(stderr, "\n[host] amostras: %llu | tempo virtual: %.1f s | tempo real: %.3f s | %.0fx\n",
+            (unsigned long long)samples_read, virtual_us / 1e6, wall / 1e9,
+            wall > 0 ? (virtual_us * 1e3) / (double)wall : 0.0);
+    fprintf(stderr, "[host] despertares da CPU: %llu (%.1f/s)\n", (unsigned long long)wakeups,
+            virtual_us > 0 ? wakeups * 1e6 / virtual_us : 0.0);
+    fflush(stderr);
+    profiler_dump();
+}
+
+void hal_init(void) {
+    const char *env = getenv("DEPLOY_REPLAY");
+
+    if (env != NULL && env[0] != '\0') {
+        char *list = strdup(env);
+        for (char *tok = strtok(list, ":"); tok != NULL; tok = strtok(NULL, ":")) {
+            add_replay_file(tok);
+        }
+        free(list);
+    } else {
+        const char *names[] = { "parado", "caminhando", "correndo", "pulando" };
+        char path[512];
+        for (int i = 0; i < 4; i++) {
+            snprintf(path, sizeof(path), "%s/%s.csv", DEPLOY_DATA_DIR, names[i]);
+            add_replay_file(path);
+        }
+    }
+
+    const char *latency = getenv("DEPLOY_TIMER_LATENCY_US");
+    if (latency != NULL) timer_latency_us = (uint32_t)strtoul(latency, NULL, 10);
+
+    fetch_next_row();
+    wall_start_ns = wall_ns();
+    atexit(print_report);
+}
+
+void hal_imu_init(void) {
+}
+
+bool hal_running(void) {
+    return has_next;
+}
+
+uint32_t hal_millis(void) {
+    return (uint32_t)(sim_clock_now_us() / 1000);
+}
+
+uint32_t hal_micros(void) {
+    return (uint32_t)sim_clock_now_us();
+}
+
+void hal_sleep_ms(uint32_t ms) {
+    sim_clock_advance_us((uint64_t)ms * 1000);
+    wakeups++;
+}
+
+void hal_sleep_us(uint32_t us) {
+    sim_clock_advance_us(us);
+    wakeups++;
+}
+
+uint32_t hal_timer_start(uint32_t period_us) {
+    return sim_clock_timer_start(period_us, timer_latency_us, 1);
+}
+
+uint32_t hal_timer_wait(void) {
+    wakeups++;
+    return sim_clock_timer_wait();
+}
+
+uint32_t hal_timer_missed(void) {
+    return sim_clock_timer_missed();
+}
+
+void hal_read_imu(int16_t *accel, int16_t *gyro) {
+    if (!has_next) {
+        memset(accel, 0, 3 * sizeof(int16_t));
+        memset(gyro, 0, 3 * sizeof(int16_t));
+        return;
+    }
+
+    if (upsample_phase == 0) {
+        memcpy(cur_row, next_row, sizeof(cur_row));
+        fetch_next_row();
+    }
+
+    int16_t row[6];
+    for (int i = 0; i < 6; i++) {
+        int32_t step = has_next ? next_row[i] - cur_row[i] : 0;
+        row[i] = (int16_t)(cur_row[i] + step * upsample_phase / REPLAY_UPSAMPLE);
+    }
+    upsample_phase = (upsample_phase + 1) % REPLAY_UPSAMPLE;
+
+    memcpy(accel, &row[0], 3 * sizeof(int16_t));
+    memcpy(gyro, &row[3], 3 * sizeof(int16_t));
+    samples_read++;
+}
+
+int hal_read_imu_batch(int16_t (*accel)[3], int16_t (*gyro)[3], int max_samples) {
+    int n = 0;
+    while (n < max_samples && has_next) {
+        hal_read_imu(accel[n], gyro[n]);
+        n++;
+    }
+    return n;
+}
+
+int hal_imu_pending(void) {
+    return 0;
+}
+
+void hal_led_put(uint32_t pin, bool on) {
+    (void)pin;
+    (void)on;
+}
+
+uint32_t hal_cycles(void) {
+    return (uint32_t)wall_ns();
+}
+
+uint32_t hal_cycles_per_us(void) {
+    return 1000;
+}
+
+int hal_console_getchar(void) {
+    return -1;
+}
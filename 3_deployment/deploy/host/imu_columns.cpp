@@ -0,0 +1,185 @@
+#include "imu_columns.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "recording.h"
+
+namespace imucol {
+
+static size_t align_up(size_t v) {
+    return (v + kColumnAlign - 1) / kColumnAlign * kColumnAlign;
+}
+
+static bool ends_with(const std::string &s, const char *suffix) {
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+ColumnFile::~ColumnFile() {
+    release();
+}
+
+ColumnFile::ColumnFile(ColumnFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+ColumnFile &ColumnFile::operator=(ColumnFile &&other) noexcept {
+    if (this == &other) return *this;
+    release();
+    header_ = other.header_;
+    label_ = std::move(other.label_);
+    error_ = std::move(other.error_);
+    num_samples_ = other.num_samples_;
+    map_ = other.map_;
+    map_bytes_ = other.map_bytes_;
+    owned_ = std::move(other.owned_);
+    for (int a = 0; a < kAxes; a++) columns_[a] = other.columns_[a];
+    // Colunas do CSV apontam para owned_, que mudou de dono sem realocar
+    other.map_ = nullptr;
+    other.map_bytes_ = 0;
+    other.num_samples_ = 0;
+    return *this;
+}
+
+void ColumnFile::release() {
+    if (map_ != nullptr) munmap(map_, map_bytes_);
+    map_ = nullptr;
+    map_bytes_ = 0;
+    owned_.clear();
+    num_samples_ = 0;
+}
+
+bool ColumnFile::open(const std::string &path) {
+    release();
+    error_.clear();
+    return ends_with(path, ".csv") ? open_csv(path) : open_mapped(path);
+}
+
+/* ---------- .imuc por mmap ---------- */
+
+bool ColumnFile::open_mapped(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = "nao foi possivel abrir " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ImuColumnsHeader)) {
+        close(fd);
+        error_ = path + ": arquivo curto demais";
+        return false;
+    }
+
+    map_bytes_ = (size_t)st.st_size;
+    map_ = mmap(nullptr, map_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map_ == MAP_FAILED) {
+        map_ = nullptr;
+        error_ = path + ": mmap falhou";
+        return false;
+    }
+    madvise(map_, map_bytes_, MADV_SEQUENTIAL);
+
+    memcpy(&header_, map_, sizeof(header_));
+    if (memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0) {
+        error_ = path + ": nao e um arquivo .imuc";
+    } else if (header_.version_major != kVersionMajor) {
+        error_ = path + ": versao " + std::to_string(header_.version_major) + " nao suportada";
+    } else if (header_.num_axes != kAxes || header_.header_bytes < sizeof(ImuColumnsHeader)) {
+        error_ = path + ": cabecalho invalido";
+    } else {
+        for (int a = 0; a < kAxes; a++) {
+            uint64_t off = header_.column_offset[a];
+            if (off % alignof(int16_t) != 0 || off > map_bytes_ ||
+                header_.num_samples > (map_bytes_ - off) / sizeof(int16_t)) {
+                error_ = path + ": coluna fora do arquivo";
+                break;
+            }
+            columns_[a] = (const int16_t *)((const uint8_t *)map_ + off);
+        }
+    }
+    if (!error_.empty()) {
+        release();
+        return false;
+    }
+
+    num_samples_ = (size_t)header_.num_samples;
+    label_.assign(header_.label, strnlen(header_.label, sizeof(header_.label)));
+    return true;
+}
+
+/* ---------- CSV transposto em memória ---------- */
+
+bool ColumnFile::open_csv(const std::string &path) {
+    ::Recording rec;
+    if (!recording_load(path.c_str(), &rec)) {
+        error_ = "nao foi possivel abrir " + path;
+        return false;
+    }
+
+    num_samples_ = rec.count;
+    owned_.resize((size_t)kAxes * rec.count);
+    for (int a = 0; a < kAxes; a++) {
+        int16_t *col = &owned_[(size_t)a * rec.count];
+        for (size_t i = 0; i < rec.count; i++) col[i] = rec.rows[i][a];
+        columns_[a] = col;
+    }
+
+    memcpy(header_.magic, kMagic, sizeof(kMagic));
+    header_.version_major = kVersionMajor;
+    header_.version_minor = kVersionMinor;
+    header_.num_samples = rec.count;
+    header_.sample_rate_hz = 0.0f;   // desconhecida no CSV
+    header_.accel_lsb_per_g = kDefaultAccelLsbPerG;
+    header_.gyro_lsb_per_dps = kDefaultGyroLsbPerDps;
+    header_.num_axes = kAxes;
+    header_.header_bytes = sizeof(ImuColumnsHeader);
+    label_ = rec.label;
+    recording_free(&rec);
+    return true;
+}
+
+/* ---------- Escrita ---------- */
+
+bool write_file(const std::string &path, const std::string &label, float sample_rate_hz,
+                const int16_t *const columns[kAxes], size_t num_samples,
+                float accel_lsb_per_g, float gyro_lsb_per_dps) {
+    ImuColumnsHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version_major = kVersionMajor;
+    h.version_minor = kVersionMinor;
+    h.num_samples = num_samples;
+    h.sample_rate_hz = sample_rate_hz;
+    h.accel_lsb_per_g = accel_lsb_per_g;
+    h.gyro_lsb_per_dps = gyro_lsb_per_dps;
+    h.num_axes = kAxes;
+    h.header_bytes = sizeof(h);
+    snprintf(h.label, sizeof(h.label), "%s", label.c_str());
+
+    size_t offset = align_up(sizeof(h));
+    for (int a = 0; a < kAxes; a++) {
+        h.column_offset[a] = offset;
+        offset = align_up(offset + num_samples * sizeof(int16_t));
+    }
+
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp == NULL) return false;
+
+    static const uint8_t zeros[kColumnAlign] = {0};
+    size_t pos = fwrite(&h, 1, sizeof(h), fp);
+    for (int a = 0; a < kAxes; a++) {
+        pos += fwrite(zeros, 1, h.column_offset[a] - pos, fp);
+        pos += fwrite(columns[a], sizeof(int16_t), num_samples, fp) * sizeof(int16_t);
+    }
+    return fclose(fp) == 0 && pos == h.column_offset[kAxes - 1] + num_samples * sizeof(int16_t);
+}
+
+} // namespace imucol
@@ -0,0 +1,116 @@
+#ifndef IMU_COLUMNS_H
+#define IMU_COLUMNS_H
+
+// Formato colunar binário das gravações do IMU (.imuc) e leitor por mmap.
+//
+// Arquivo (little-endian, lido direto na memória do host):
+//   cabeçalho de 128 bytes (ImuColumnsHeader)
+//   6 colunas int16 (ax, ay, az, gx, gy, gz), cada uma com num_samples
+//   valores e início alinhado a 64 bytes (column_offset[] no cabeçalho)
+//
+// O leitor não copia nem converte nada: as janelas são ponteiros para
+// dentro do mapeamento, então arquivos de vários GB são percorridos sem
+// parsing e sem alocação por janela. Versões com o mesmo major são
+// compatíveis; campos novos entram em reserved ou além de header_bytes.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace imucol {
+
+constexpr char kMagic[4] = { 'I', 'M', 'U', 'C' };
+constexpr uint16_t kVersionMajor = 1;
+constexpr uint16_t kVersionMinor = 0;
+constexpr int kAxes = 6;
+constexpr size_t kColumnAlign = 64;
+
+// Escalas do collect_data (±2 g, ±250 °/s)
+constexpr float kDefaultAccelLsbPerG = 16384.0f;
+constexpr float kDefaultGyroLsbPerDps = 131.0f;
+
+struct ImuColumnsHeader {
+    char magic[4];
+    uint16_t version_major;
+    uint16_t version_minor;
+    uint64_t num_samples;
+    float sample_rate_hz;
+    float accel_lsb_per_g;
+    float gyro_lsb_per_dps;
+    uint16_t num_axes;
+    uint16_t header_bytes;
+    char label[32];
+    uint64_t column_offset[kAxes];
+    uint8_t reserved[16];
+};
+static_assert(sizeof(ImuColumnsHeader) == 128, "cabecalho .imuc tem 128 bytes");
+
+// Janela de amostras consecutivas: um ponteiro por eixo, sem cópia
+struct WindowView {
+    const int16_t *axis[kAxes];
+    size_t length;
+
+    // Amostra i nos vetores do firmware (accel[3], gyro[3])
+    void sample(size_t i, int16_t *accel, int16_t *gyro) const {
+        for (int a = 0; a < 3; a++) {
+            accel[a] = axis[a][i];
+            gyro[a] = axis[3 + a][i];
+        }
+    }
+};
+
+// Gravação aberta: mapeada de um .imuc ou, para CSV, lida e transposta
+// para colunas em memória própria (mesma interface)
+class ColumnFile {
+public:
+    ColumnFile() = default;
+    ~ColumnFile();
+    ColumnFile(const ColumnFile &) = delete;
+    ColumnFile &operator=(const ColumnFile &) = delete;
+    ColumnFile(ColumnFile &&other) noexcept;
+    ColumnFile &operator=(ColumnFile &&other) noexcept;
+
+    // Abre .imuc (mmap) ou .csv (pela extensão); em erro retorna false e
+    // preenche error()
+    bool open(const std::string &path);
+
+    const std::string &error() const { return error_; }
+    const std::string &label() const { return label_; }
+    size_t size() const { return num_samples_; }
+    float sample_rate_hz() const { return header_.sample_rate_hz; }
+    const ImuColumnsHeader &header() const { return header_; }
+    const int16_t *column(int axis) const { return columns_[axis]; }
+
+    WindowView window(size_t first, size_t length) const {
+        WindowView w;
+        for (int a = 0; a < kAxes; a++) w.axis[a] = columns_[a] + first;
+        w.length = length;
+        return w;
+    }
+
+private:
+    bool open_mapped(const std::string &path);
+    bool open_csv(const std::string &path);
+    void release();
+
+    ImuColumnsHeader header_ = {};
+    std::string label_;
+    std::string error_;
+    size_t num_samples_ = 0;
+    const int16_t *columns_[kAxes] = {};
+
+    void *map_ = nullptr;
+    size_t map_bytes_ = 0;
+    std::vector<int16_t> owned_;   // colunas do CSV
+};
+
+// Escreve um .imuc a partir de colunas; label é truncado em 31 caracteres
+bool write_file(const std::string &path, const std::string &label, float sample_rate_hz,
+                const int16_t *const columns[kAxes], size_t num_samples,
+                float accel_lsb_per_g = kDefaultAccelLsbPerG,
+                float gyro_lsb_per_dps = kDefaultGyroLsbPerDps);
+
+} // namespace imucol
+
+#endif
@@ -0,0 +1,208 @@
+#include "mpu6500_sim.h"
+#include "include/hal.h"
+#include "include/mpu6500.h"
+#include "config.h"
+#include <string.h>
+
+#define REG_SMPLRT_DIV 0x19
+#define REG_CONFIG 0x1A
+#define REG_FIFO_EN 0x23
+#define REG_INT_STATUS 0x3A
+#define REG_ACCEL_XOUT_H 0x3B
+#define REG_GYRO_XOUT_H 0x43
+#define REG_USER_CTRL 0x6A
+#define REG_PWR_MGMT_1 0x6B
+#define REG_FIFO_COUNTH 0x72
+#define REG_FIFO_COUNTL 0x73
+#define REG_FIFO_R_W 0x74
+#define REG_WHO_AM_I 0x75
+
+#define SLEEP_BIT 0x40
+#define FIFO_MODE_BIT 0x40
+#define FIFO_OFLOW_BIT 0x10
+#define USER_CTRL_FIFO_EN 0x40
+#define USER_CTRL_FIFO_RST 0x04
+
+static struct {
+    uint8_t regs[128];
+    uint8_t ptr;
+
+    uint8_t fifo[MPU6500_FIFO_SIZE];
+    uint16_t fifo_head;
+    uint16_t fifo_count;
+
+    uint32_t clock_us;
+    uint32_t next_sample_us;
+
+    Mpu6500SimSource source;
+    void *ctx;
+    bool exhausted;
+    Mpu6500SimStats stats;
+} sim;
+
+static void fifo_reset(void) {
+    sim.fifo_head = 0;
+    sim.fifo_count = 0;
+}
+
+static void fifo_put(const uint8_t *bytes, int len) {
+    if (sim.fifo_count + len > MPU6500_FIFO_SIZE) {
+        sim.regs[REG_INT_STATUS] |= FIFO_OFLOW_BIT;
+        if (sim.regs[REG_CONFIG] & FIFO_MODE_BIT) {
+            sim.stats.samples_lost++;
+            return;
+        }
+        // Modo sobrescrita: descarta os bytes mais antigos
+        int excess = sim.fifo_count + len - MPU6500_FIFO_SIZE;
+        sim.fifo_head = (uint16_t)((sim.fifo_head + excess) % MPU6500_FIFO_SIZE);
+        sim.fifo_count = (uint16_t)(sim.fifo_count - excess);
+    }
+
+    for (int i = 0; i < len; i++) {
+        sim.fifo[(sim.fifo_head + sim.fifo_count) % MPU6500_FIFO_SIZE] = bytes[i];
+        sim.fifo_count++;
+    }
+}
+
+static uint8_t fifo_pop(void) {
+    if (sim.fifo_count == 0) return 0xFF;
+    uint8_t v = sim.fifo[sim.fifo_head];
+    sim.fifo_head = (uint16_t)((sim.fifo_head + 1) % MPU6500_FIFO_SIZE);
+    sim.fifo_count--;
+    return v;
+}
+
+static void put_be16(uint8_t *p, int16_t v) {
+    p[0] = (uint8_t)((uint16_t)v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+// Mede uma amostra: atualiza os registradores de dados e, se habilitado, o FIFO
+static void measure(void) {
+    int16_t accel[3], gyro[3];
+
+    if (sim.exhausted || !sim.source(accel, gyro, sim.ctx)) {
+        sim.exhausted = true;
+        return;
+    }
+    sim.stats.samples_measured++;
+
+    for (int i = 0; i < 3; i++) {
+        put_be16(&sim.regs[REG_ACCEL_XOUT_H + 2 * i], accel[i]);
+        put_be16(&sim.regs[REG_GYRO_XOUT_H + 2 * i], gyro[i]);
+    }
+
+    if (!(sim.regs[REG_USER_CTRL] & USER_CTRL_FIFO_EN)) return;
+
+    // Ordem do FIFO: registradores crescentes (ACCEL, TEMP, GYRO)
+    uint8_t frame[14];
+    int len = 0;
+    uint8_t en = sim.regs[REG_FIFO_EN];
+    if (en & 0x08) { memcpy(&frame[len], &sim.regs[REG_ACCEL_XOUT_H], 6); len += 6; }
+    if (en & 0x80) { memcpy(&frame[len], &sim.regs[REG_ACCEL_XOUT_H + 6], 2); len += 2; }
+    if (en & 0x40) { memcpy(&frame[len], &sim.regs[REG_GYRO_XOUT_H], 2); len += 2; }
+    if (en & 0x20) { memcpy(&frame[len], &sim.regs[REG_GYRO_XOUT_H + 2], 2); len += 2; }
+    if (en & 0x10) { memcpy(&frame[len], &sim.regs[REG_GYRO_XOUT_H + 4], 2); len += 2; }
+    if (len > 0) fifo_put(frame, len);
+}
+
+static void write_reg(uint8_t reg, uint8_t value) {
+    switch (reg) {
+        case REG_SMPLRT_DIV:
+        case REG_CONFIG:
+            // Nova taxa vale a partir do próximo período
+            sim.regs[reg] = value;
+            sim.next_sample_us = sim.clock_us + mpu6500_sim_sample_period_us();
+            break;
+        case REG_USER_CTRL:
+            if (value & USER_CTRL_FIFO_RST) fifo_reset();
+            sim.regs[reg] = value & (uint8_t)~USER_CTRL_FIFO_RST; // auto-limpa
+            break;
+        case REG_INT_STATUS:
+        case REG_FIFO_COUNTH:
+        case REG_FIFO_COUNTL:
+        case REG_WHO_AM_I:
+            break; // somente leitura
+        case REG_FIFO_R_W:
+            fifo_put(&value, 1);
+            break;
+        default:
+            sim.regs[reg] = value;
+    }
+}
+
+static uint8_t read_reg(uint8_t reg) {
+    uint8_t v;
+    switch (reg) {
+        case REG_INT_STATUS:
+            v = sim.regs[reg];
+            sim.regs[reg] = 0; // limpa na leitura
+            return v;
+        case REG_FIFO_COUNTH:
+            return (uint8_t)(sim.fifo_count >> 8);
+        case REG_FIFO_COUNTL:
+            return (uint8_t)sim.fifo_count;
+        case REG_FIFO_R_W:
+            return fifo_pop();
+        default:
+            return sim.regs[reg];
+    }
+}
+
+void mpu6500_sim_init(Mpu6500SimSource source, void *ctx) {
+    memset(&sim, 0, sizeof(sim));
+    sim.regs[REG_PWR_MGMT_1] = SLEEP_BIT; // sai do reset dormindo
+    sim.regs[REG_WHO_AM_I] = 0x70;
+    sim.source = source;
+    sim.ctx = ctx;
+    sim.next_sample_us = mpu6500_sim_sample_period_us();
+}
+
+uint32_t mpu6500_sim_sample_period_us(void) {
+    // Com DLPF (CFG 1..6) a taxa interna é 1 kHz; sem DLPF, 8 kHz
+    uint8_t dlpf = sim.regs[REG_CONFIG] & 0x07;
+    uint32_t base_us = (dlpf == 0 || dlpf == 7) ? 125 : 1000;
+    return base_us * (1u + sim.regs[REG_SMPLRT_DIV]);
+}
+
+void mpu6500_sim_advance_us(uint32_t us) {
+    uint32_t end = sim.clock_us + us;
+
+    while ((int32_t)(end - sim.next_sample_us) >= 0) {
+        sim.clock_us = sim.next_sample_us;
+        if (!(sim.regs[REG_PWR_MGMT_1] & SLEEP_BIT)) measure();
+        sim.next_sample_us += mpu6500_sim_sample_period_us();
+    }
+    sim.clock_us = end;
+}
+
+const Mpu6500SimStats* mpu6500_sim_stats(void) {
+    return &sim.stats;
+}
+
+/* ---------- Barramento I2C do host ---------- */
+int hal_i2c_write(uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    if (addr != MPU6500_ADDR || len == 0) return -1;
+
+    sim.stats.i2c_writes++;
+    sim.ptr = src[0] & 0x7F;
+    for (size_t i = 1; i < len; i++) {
+        write_reg(sim.ptr, src[i]);
+        if (sim.ptr != REG_FIFO_R_W) sim.ptr = (sim.ptr + 1) & 0x7F;
+    }
+    return (int)len;
+}
+
+int hal_i2c_read(uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)nostop;
+    if (addr != MPU6500_ADDR) return -1;
+
+    sim.stats.i2c_reads++;
+    sim.stats.bytes_read += (uint32_t)len;
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = read_reg(sim.ptr);
+        if (sim.ptr != REG_FIFO_R_W) sim.ptr = (sim.ptr + 1) & 0x7F;
+    }
+    return (int)len;
+}
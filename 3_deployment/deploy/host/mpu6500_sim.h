@@ -0,0 +1,39 @@
+#ifndef MPU6500_SIM_H
+#define MPU6500_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Modelo do MPU6500 no nível de registradores, atrás de hal_i2c_write /
+// hal_i2c_read: ponteiro de registrador com auto-incremento, registradores
+// de dados, SMPLRT_DIV/CONFIG, FIFO de 512 bytes com FIFO_COUNT, FIFO_R_W,
+// FIFO_RST e sinalização de overflow em INT_STATUS.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fonte das amostras que o "sensor" mede; falso quando acabar
+typedef bool (*Mpu6500SimSource)(int16_t *accel, int16_t *gyro, void *ctx);
+
+typedef struct {
+    uint32_t i2c_writes;
+    uint32_t i2c_reads;
+    uint32_t bytes_read;
+    uint32_t samples_measured;
+    uint32_t samples_lost;      // medidas que não couberam no FIFO
+} Mpu6500SimStats;
+
+void mpu6500_sim_init(Mpu6500SimSource source, void *ctx);
+
+// Avança o tempo do sensor, medindo amostras na taxa configurada
+void mpu6500_sim_advance_us(uint32_t us);
+
+uint32_t mpu6500_sim_sample_period_us(void);
+const Mpu6500SimStats* mpu6500_sim_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,45 @@
+#include "recording.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void label_from_path(const char *path, char *label, size_t len) {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+
+    snprintf(label, len, "%s", base);
+    char *dot = strrchr(label, '.');
+    if (dot != NULL) *dot = '\0';
+}
+
+bool recording_load(const char *path, Recording *rec) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) return false;
+
+    size_t cap = 1024;
+    rec->rows = malloc(cap * sizeof(*rec->rows));
+    rec->count = 0;
+    label_from_path(path, rec->label, sizeof(rec->label));
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int v[6];
+        if (sscanf(line, "%d,%d,%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) continue;
+
+        if (rec->count == cap) {
+            cap *= 2;
+            rec->rows = realloc(rec->rows, cap * sizeof(*rec->rows));
+        }
+        for (int i = 0; i < 6; i++) rec->rows[rec->count][i] = (int16_t)v[i];
+        rec->count++;
+    }
+
+    fclose(fp);
+    return true;
+}
+
+void recording_free(Recording *rec) {
+    free(rec->rows);
+    rec->rows = NULL;
+    rec->count = 0;
+}
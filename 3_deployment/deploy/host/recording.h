@@ -0,0 +1,27 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Gravação bruta carregada de um CSV de data/ (ax,ay,az,gx,gy,gz por linha)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int16_t (*rows)[6];
+    size_t count;
+    char label[64];   // nome do arquivo sem diretório e sem ".csv"
+} Recording;
+
+bool recording_load(const char *path, Recording *rec);
+void recording_free(Recording *rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
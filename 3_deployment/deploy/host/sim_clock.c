@@ -0,0 +1,59 @@
+#include "sim_clock.h"
+
+static uint64_t now_us = 0;
+static uint64_t next_tick_us = 0;
+static uint32_t timer_period_us = 0;
+static uint32_t latency_max_us = 0;
+static uint32_t rng_state = 1;
+static uint32_t wakeups = 0;
+static uint32_t missed = 0;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+uint64_t sim_clock_now_us(void) {
+    return now_us;
+}
+
+void sim_clock_advance_us(uint64_t us) {
+    now_us += us;
+}
+
+uint32_t sim_clock_timer_start(uint32_t period_us, uint32_t max_latency_us, uint32_t seed) {
+    timer_period_us = period_us;
+    latency_max_us = max_latency_us;
+    rng_state = seed ? seed : 1;
+    next_tick_us = now_us + period_us;
+    wakeups = 0;
+    missed = 0;
+    return (uint32_t)next_tick_us;
+}
+
+uint32_t sim_clock_timer_wait(void) {
+    if (now_us >= next_tick_us) {
+        // Alarme já pendente: retorna na hora e conta os ticks vencidos
+        while (next_tick_us + timer_period_us <= now_us) {
+            next_tick_us += timer_period_us;
+            missed++;
+        }
+    } else {
+        uint32_t latency = latency_max_us ? xorshift32() % (latency_max_us + 1) : 0;
+        now_us = next_tick_us + latency;
+    }
+
+    next_tick_us += timer_period_us;
+    wakeups++;
+    return (uint32_t)now_us;
+}
+
+uint32_t sim_clock_wakeups(void) {
+    return wakeups;
+}
+
+uint32_t sim_clock_timer_missed(void) {
+    return missed;
+}
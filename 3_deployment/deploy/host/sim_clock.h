@@ -0,0 +1,28 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+// Relógio virtual do host e timer de amostragem simulado. O timer dispara
+// numa grade fixa; cada despertar soma uma latência pseudoaleatória em
+// [0, max_latency_us], e ticks vencidos enquanto o "core" trabalhava são
+// coalescidos, como a flag do alarme no RP2040.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t sim_clock_now_us(void);
+void sim_clock_advance_us(uint64_t us);
+
+// Retorna o instante do primeiro disparo
+uint32_t sim_clock_timer_start(uint32_t period_us, uint32_t max_latency_us, uint32_t seed);
+uint32_t sim_clock_timer_wait(void);   // retorna o instante do despertar
+uint32_t sim_clock_wakeups(void);
+uint32_t sim_clock_timer_missed(void);   // ticks coalescidos por sim_clock_timer_wait
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
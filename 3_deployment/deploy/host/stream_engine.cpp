@@ -0,0 +1,199 @@
+#include "stream_engine.h"
+
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace gateway {
+
+static uint64_t now_ns() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+Engine::Engine(const EngineConfig &cfg, ResultFn on_result)
+    : cfg_(cfg), on_result_(std::move(on_result)) {
+    int n = cfg_.workers > 0 ? cfg_.workers : (int)std::thread::hardware_concurrency();
+    if (n < 1) n = 1;
+    if (cfg_.max_pending < 1) cfg_.max_pending = 1;
+    for (int w = 0; w < n; w++) queues_.emplace_back(new WorkQueue);
+}
+
+Engine::~Engine() {
+    stop();
+}
+
+bool Engine::start() {
+    if (!threads_.empty()) return true;
+    for (size_t w = 0; w < queues_.size(); w++) {
+        ai_backend_t *model = ai_instance_create();
+        if (model == nullptr) {
+            error_ = "falha ao criar instancia do modelo";
+            for (ai_backend_t *m : models_) ai_instance_destroy(m);
+            models_.clear();
+            return false;
+        }
+        models_.push_back(model);
+    }
+    stop_ = false;
+    for (size_t w = 0; w < queues_.size(); w++) {
+        threads_.emplace_back(&Engine::worker_loop, this, (int)w, models_[w]);
+    }
+    return true;
+}
+
+void Engine::stop() {
+    {
+        std::lock_guard<std::mutex> lk(wait_m_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    space_cv_.notify_all();
+    for (std::thread &t : threads_) t.join();
+    threads_.clear();
+    for (ai_backend_t *m : models_) ai_instance_destroy(m);
+    models_.clear();
+}
+
+Stream *Engine::add_stream() {
+    std::lock_guard<std::mutex> lk(streams_m_);
+    std::unique_ptr<Stream> s(new Stream);
+    s->id_ = (uint32_t)streams_.size();
+    s->home_ = (int)(s->id_ % queues_.size());
+    scheduler_init(&s->sched_, cfg_.hop);
+    motion_gate_init(&s->gate_, NULL);
+    streams_.push_back(std::move(s));
+    return streams_.back().get();
+}
+
+size_t Engine::streams() const {
+    std::lock_guard<std::mutex> lk(streams_m_);
+    return streams_.size();
+}
+
+bool Engine::push(Stream *s, int16_t *accel, int16_t *gyro) {
+    if (stop_) return false;
+    if (!scheduler_add_sample(&s->sched_, accel, gyro)) return true;
+
+    Task t;
+    int32_t features[NUM_FEATURES];
+    extract_features_q(&s->sched_.win, features);
+    t.stream = s;
+    t.window = s->windows_++;
+    t.still = cfg_.motion_gate && motion_gate_is_still(&s->gate_, features);
+    if (!t.still) features_quantize_int8(features, ai_input_quant(), t.input);
+    t.ready_ns = now_ns();
+
+    if (!reserve()) return false;
+    submit(t, s->home_);
+    return true;
+}
+
+// Vaga em pending_ por CAS, para produtores concorrentes não passarem de
+// max_pending; false depois de stop()
+bool Engine::reserve() {
+    size_t cur = pending_.load();
+    for (;;) {
+        if (stop_) return false;
+        if (cur < cfg_.max_pending) {
+            if (pending_.compare_exchange_weak(cur, cur + 1)) break;
+            continue;
+        }
+        // Fila cheia: espera os workers entregarem alguma janela
+        waiters_++;
+        {
+            std::unique_lock<std::mutex> lk(wait_m_);
+            space_cv_.wait(lk, [&] { return pending_.load() < cfg_.max_pending || stop_; });
+        }
+        waiters_--;
+        cur = pending_.load();
+    }
+    // stop() entre o teste e a reserva: os workers podem já ter saído
+    if (stop_) {
+        release();
+        return false;
+    }
+    return true;
+}
+
+// Janela entregue (ou reserva desfeita): acorda quem espera vaga ou drain()
+// e, depois de stop(), os workers que esperam pending_ zerar para sair
+void Engine::release() {
+    bool last = pending_.fetch_sub(1) == 1;
+    if (waiters_.load() > 0 || (last && stop_)) {
+        std::lock_guard<std::mutex> lk(wait_m_);
+        space_cv_.notify_all();
+        if (last && stop_) work_cv_.notify_all();
+    }
+}
+
+void Engine::submit(const Task &t, int home) {
+    {
+        std::lock_guard<std::mutex> lk(queues_[home]->m);
+        queues_[home]->q.push_back(t);
+    }
+    queued_++;
+    if (sleepers_.load() > 0) {
+        std::lock_guard<std::mutex> lk(wait_m_);
+        work_cv_.notify_one();
+    }
+}
+
+void Engine::drain() {
+    waiters_++;
+    std::unique_lock<std::mutex> lk(wait_m_);
+    space_cv_.wait(lk, [&] { return pending_.load() == 0 || stop_; });
+    waiters_--;
+}
+
+bool Engine::pop_or_steal(int w, Task *t) {
+    int n = (int)queues_.size();
+    for (int k = 0; k < n; k++) {
+        WorkQueue &wq = *queues_[(w + k) % n];
+        std::lock_guard<std::mutex> lk(wq.m);
+        if (wq.q.empty()) continue;
+        if (k == 0) {
+            *t = wq.q.front();
+            wq.q.pop_front();
+        } else {
+            *t = wq.q.back();
+            wq.q.pop_back();
+        }
+        queued_--;
+        return true;
+    }
+    return false;
+}
+
+void Engine::worker_loop(int w, ai_backend_t *model) {
+    for (;;) {
+        Task t;
+        if (!pop_or_steal(w, &t)) {
+            // Depois de stop(), só sai quando nenhuma janela aceita por push()
+            // falta ser entregue
+            if (stop_ && pending_.load() == 0) return;
+            sleepers_++;
+            std::unique_lock<std::mutex> lk(wait_m_);
+            work_cv_.wait(lk, [&] { return queued_.load() > 0 || (stop_ && pending_.load() == 0); });
+            sleepers_--;
+            continue;
+        }
+
+        Result r;
+        r.stream = t.stream->id_;
+        r.window = t.window;
+        r.gated = t.still;
+        if (t.still) {
+            r.result.cls = AI_PARADO;
+            r.result.confidence = 0;   // sem modelo, sem confiança
+        } else {
+            memcpy(ai_instance_input(model), t.input, NUM_FEATURES);
+            r.result = ai_classify_instance(model);
+        }
+        r.latency_ns = now_ns() - t.ready_ns;
+        on_result_(w, r);
+        release();
+    }
+}
+
+} // namespace gateway
@@ -0,0 +1,151 @@
+#ifndef STREAM_ENGINE_H
+#define STREAM_ENGINE_H
+
+// Motor de classificação para um gateway que agrega muitos wearables.
+//
+// Cada Stream tem seu próprio estado de janela e de features
+// (WindowScheduler + MotionGate); push() atualiza a janela em O(1) na thread
+// de quem recebe as amostras e, quando ela dispara, extrai as features Q8,
+// aplica o gate e enfileira a entrada int8 do modelo (NUM_FEATURES bytes).
+//
+// As janelas são classificadas por um pool de workers, cada um com sua
+// instância do modelo (ai_instance_create: interpretador + arena próprios) e
+// sua fila. Um stream sempre enfileira no mesmo worker; um worker sem
+// trabalho rouba do fim da fila dos outros. Janelas decididas pelo gate
+// passam pela fila também, mas sem inferência, para que todo resultado saia
+// dos workers e a latência seja medida do mesmo jeito.
+//
+// Uso: ai_init(), Engine(cfg, callback), start(), add_stream() para cada
+// wearable e push() com as amostras. Cada Stream aceita um produtor por vez;
+// streams diferentes podem receber de threads diferentes. Os resultados de
+// um stream podem chegar fora de ordem (Result::window diz a sequência).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/ai_core.h"
+#include "include/motion_gate.h"
+#include "include/window_scheduler.h"
+
+namespace gateway {
+
+struct EngineConfig {
+    int workers = 0;              // 0: std::thread::hardware_concurrency
+    int hop = WINDOW_HOP;         // amostras entre janelas de um stream
+    bool motion_gate = true;
+    size_t max_pending = 65536;   // janelas na fila antes de push() esperar
+};
+
+struct Result {
+    uint32_t stream;
+    uint32_t window;        // sequência da janela no stream (0, 1, ...)
+    ai_result_t result;
+    bool gated;             // decidida pelo gate, sem inferência (confidence 0)
+    uint64_t latency_ns;    // da janela fechar em push() até o resultado
+};
+
+// Chamado na thread do worker (0..workers-1) que classificou a janela
+using ResultFn = std::function<void(int worker, const Result &)>;
+
+class Stream {
+public:
+    uint32_t id() const { return id_; }
+    uint32_t windows() const { return windows_; }     // janelas enfileiradas
+    uint32_t gated() const { return gate_.still; }    // decididas pelo gate
+
+private:
+    friend class Engine;
+
+    uint32_t id_ = 0;
+    int home_ = 0;   // worker em cuja fila as janelas entram
+    uint32_t windows_ = 0;
+    WindowScheduler sched_;
+    MotionGate gate_;
+};
+
+class Engine {
+public:
+    Engine(const EngineConfig &cfg, ResultFn on_result);
+    ~Engine();
+    Engine(const Engine &) = delete;
+    Engine &operator=(const Engine &) = delete;
+
+    // Cria as instâncias do modelo e inicia os workers (ai_init antes); em
+    // erro retorna false e preenche error()
+    bool start();
+
+    // Pode ser chamado a qualquer momento; o ponteiro vale até o destrutor
+    Stream *add_stream();
+
+    // Uma amostra do stream; espera se houver max_pending janelas na fila.
+    // Retorna false (amostra descartada) depois de stop()
+    bool push(Stream *s, int16_t *accel, int16_t *gyro);
+
+    // Espera todas as janelas enfileiradas serem classificadas
+    void drain();
+
+    // Recusa novas amostras e para os workers depois de entregarem todas as
+    // janelas já aceitas
+    void stop();
+
+    int workers() const { return (int)queues_.size(); }
+    size_t streams() const;
+    const std::string &error() const { return error_; }
+
+private:
+    struct Task {
+        Stream *stream;
+        uint32_t window;
+        bool still;
+        uint64_t ready_ns;
+        int8_t input[NUM_FEATURES];
+    };
+
+    // Fila de um worker: o dono tira da frente, os ladrões do fim
+    struct alignas(64) WorkQueue {
+        std::mutex m;
+        std::deque<Task> q;
+    };
+
+    void worker_loop(int w, ai_backend_t *model);
+    bool pop_or_steal(int w, Task *t);
+    bool reserve();
+    void release();
+    void submit(const Task &t, int home);
+
+    EngineConfig cfg_;
+    ResultFn on_result_;
+    std::string error_;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<ai_backend_t *> models_;
+    std::vector<std::thread> threads_;
+
+    mutable std::mutex streams_m_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+
+    // pending_: janelas enfileiradas e ainda não entregues; queued_: ainda
+    // em alguma fila. Dormir e acordar passam por wait_m_ para não perder
+    // notificações
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> queued_{0};
+    std::atomic<int> sleepers_{0};
+    std::atomic<int> waiters_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex wait_m_;
+    std::condition_variable work_cv_;    // workers sem trabalho
+    std::condition_variable space_cv_;   // produtores e drain()
+};
+
+} // namespace gateway
+
+#endif
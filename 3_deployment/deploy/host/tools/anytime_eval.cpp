@@ -0,0 +1,223 @@
+// Mede a classificação antecipada (WindowScheduler com scheduler_set_anytime)
+// contra o caminho padrão, reproduzindo boots em vários pontos de data/*.csv.
+//
+//   anytime_eval [-m min_amostras] [-s passo] [-c confianca] [-b espacamento]
+//                [-H horizonte] [-G] [arquivo.csv ...]
+//
+// Cada gravação é reproduzida a partir de um boot a cada -b amostras, por
+// -H amostras (padrão: 3 janelas), com o mesmo extrator, gate de movimento
+// (-G desliga) e backend do firmware. Em cada boot o modo padrão só
+// classifica com a janela cheia; o antecipado também dispara com -m
+// amostras e a cada -s até encher, e para de disparar quando um provisório
+// chega a -c décimos de % de confiança (ANYTIME_* em config.h).
+//
+// Imprime a acurácia de cada comprimento parcial (para escolher -m), e para
+// os dois modos: tempo até o primeiro rótulo e até o primeiro rótulo certo
+// (média, p50, p90; boots sem acerto contam o horizonte), acurácia do
+// primeiro rótulo, acurácia dos rótulos emitidos antes da janela encher e
+// inferências por boot até a primeira janela cheia.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "include/ai_core.h"
+#include "include/motion_gate.h"
+#include "include/window_scheduler.h"
+#include "recording.h"
+
+static const char *class_names[NUM_CLASSES] = { "caminhando", "correndo", "parado", "pulando" };
+
+struct AnytimeConfig {
+    int min_samples = ANYTIME_MIN_SAMPLES;
+    int step = ANYTIME_STEP;
+    int confidence = ANYTIME_CONFIDENCE;
+    bool gate = true;
+};
+
+// Resultado de um boot num modo
+struct BootRun {
+    int first_label = -1;     // amostras até o primeiro rótulo
+    int first_correct = -1;   // amostras até o primeiro rótulo certo
+    bool first_ok = false;
+    int early_labels = 0, early_hits = 0;   // antes da janela encher
+    int fill_inferences = 0;                // até a primeira janela cheia, inclusive
+};
+
+struct ModeReport {
+    std::vector<int> to_label, to_correct;
+    long boots = 0, first_hits = 0, misses = 0;
+    long early_labels = 0, early_hits = 0, fill_inferences = 0;
+};
+
+static int label_of(const char *name) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        if (strncmp(name, class_names[c], strlen(class_names[c])) == 0) return c;
+    }
+    return -1;
+}
+
+// Como process_sample em main.c: decidida pelo gate, sai parado com
+// confiança 0 e *gated
+static ai_result_t classify(WindowBuffer *win, MotionGate *gate, bool use_gate, bool *gated) {
+    int32_t features[NUM_FEATURES];
+    extract_features_q(win, features);
+    *gated = use_gate && motion_gate_is_still(gate, features);
+    if (*gated) return ai_result_t{ AI_PARADO, 0 };
+    features_quantize_int8(features, ai_input_quant(), ai_input_buffer());
+    return ai_classify();
+}
+
+static BootRun run_boot(const Recording &rec, size_t start, int horizon, int label, bool anytime,
+                        const AnytimeConfig &cfg) {
+    static WindowScheduler sched;
+    MotionGate gate;
+    scheduler_init(&sched, WINDOW_HOP);
+    if (anytime) scheduler_set_anytime(&sched, cfg.min_samples, cfg.step);
+    motion_gate_init(&gate, NULL);
+
+    BootRun r;
+    for (int k = 1; k <= horizon; k++) {
+        int16_t *s = rec.rows[start + k - 1];
+        if (!scheduler_add_sample(&sched, &s[0], &s[3])) continue;
+
+        bool gated;
+        ai_result_t res = classify(&sched.win, &gate, cfg.gate, &gated);
+        bool hit = res.cls == label;
+        if (r.first_label < 0) {
+            r.first_label = k;
+            r.first_ok = hit;
+        }
+        if (hit && r.first_correct < 0) r.first_correct = k;
+        if (k <= WINDOW_SIZE) r.fill_inferences++;
+        if (sched.provisional) {
+            r.early_labels++;
+            r.early_hits += hit;
+            // O gate não tem confiança: só o modelo encerra os disparos
+            if (!gated && res.confidence >= cfg.confidence) scheduler_settle(&sched);
+        }
+    }
+    return r;
+}
+
+static void add(ModeReport *m, const BootRun &r, int horizon) {
+    m->boots++;
+    m->to_label.push_back(r.first_label < 0 ? horizon : r.first_label);
+    m->to_correct.push_back(r.first_correct < 0 ? horizon : r.first_correct);
+    m->misses += r.first_correct < 0;
+    m->first_hits += r.first_ok;
+    m->early_labels += r.early_labels;
+    m->early_hits += r.early_hits;
+    m->fill_inferences += r.fill_inferences;
+}
+
+static double percentile_ms(std::vector<int> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(p * (double)(v.size() - 1) + 0.5)] * (double)SAMPLE_INTERVAL_MS;
+}
+
+static double mean_ms(const std::vector<int> &v) {
+    double s = 0;
+    for (int x : v) s += x;
+    return v.empty() ? 0.0 : s / v.size() * SAMPLE_INTERVAL_MS;
+}
+
+static void print_mode(const char *name, const ModeReport &m) {
+    char early[16] = "-";
+    if (m.early_labels > 0) snprintf(early, sizeof(early), "%.1f%%", 100.0 * m.early_hits / m.early_labels);
+    printf("%-11s %7.0f %7.0f %7.0f %7.0f %7.0f %6ld %8.1f%% %9s %9.2f\n", name, mean_ms(m.to_label),
+           mean_ms(m.to_correct), percentile_ms(m.to_correct, 0.5), percentile_ms(m.to_correct, 0.9),
+           percentile_ms(m.to_correct, 1.0), m.misses, 100.0 * m.first_hits / m.boots, early,
+           (double)m.fill_inferences / m.boots);
+}
+
+int main(int argc, char **argv) {
+    AnytimeConfig cfg;
+    int spacing = 5, horizon = 3 * WINDOW_SIZE;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) cfg.min_samples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) cfg.step = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) cfg.confidence = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) spacing = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) horizon = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-G") == 0) cfg.gate = false;
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+    if (spacing < 1) spacing = 1;
+    if (horizon < WINDOW_SIZE) horizon = WINDOW_SIZE;
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+
+    ModeReport full, early;
+    long len_hits[WINDOW_SIZE + 1] = {0}, len_total = 0;
+
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            return 2;
+        }
+        int label = label_of(rec.label);
+        if (label < 0) {
+            fprintf(stderr, "%s: classe desconhecida\n", rec.label);
+            return 2;
+        }
+
+        for (size_t start = 0; start + (size_t)horizon <= rec.count; start += (size_t)spacing) {
+            add(&full, run_boot(rec, start, horizon, label, false, cfg), horizon);
+            add(&early, run_boot(rec, start, horizon, label, true, cfg), horizon);
+
+            // Acurácia de cada comprimento parcial, sem passo nem parada
+            static WindowBuffer win;
+            MotionGate gate;
+            window_init(&win);
+            motion_gate_init(&gate, NULL);
+            for (int n = 1; n <= WINDOW_SIZE; n++) {
+                int16_t *s = rec.rows[start + n - 1];
+                window_add_sample(&win, &s[0], &s[3]);
+                bool gated;
+                if (n >= 2) len_hits[n] += classify(&win, &gate, cfg.gate, &gated).cls == label;
+            }
+            len_total++;
+        }
+        recording_free(&rec);
+    }
+    if (full.boots == 0) {
+        fprintf(stderr, "gravacoes mais curtas que o horizonte (%d amostras)\n", horizon);
+        return 2;
+    }
+
+    printf("%ld boots (a cada %d amostras, horizonte %d ms) | gate: %s\n\n", full.boots, spacing,
+           horizon * SAMPLE_INTERVAL_MS, cfg.gate ? "sim" : "nao");
+
+    printf("acuracia por comprimento da janela parcial:\n");
+    for (int n = 2; n <= WINDOW_SIZE; n++) {
+        printf("  %3d amostras (%4d ms): %5.1f%%%s\n", n, n * SAMPLE_INTERVAL_MS, 100.0 * len_hits[n] / len_total,
+               n == WINDOW_SIZE ? " (janela cheia)" : "");
+    }
+
+    printf("\nantecipado: min %d amostras, passo %d, para com confianca >= %d.%d%% (tempos em ms desde o boot)\n",
+           cfg.min_samples,
+           cfg.step, cfg.confidence / 10, cfg.confidence % 10);
+    printf("%-11s %7s %7s %7s %7s %7s %6s %9s %9s %9s\n", "", "1o rot", "certo", "p50", "p90", "max",
+           "erros", "1o certo", "parciais", "inf/boot");
+    print_mode("padrao", full);
+    print_mode("antecipado", early);
+
+    printf("\ntempo medio ate o primeiro rotulo certo: %.0f ms -> %.0f ms (%+.0f ms)\n", mean_ms(full.to_correct),
+           mean_ms(early.to_correct), mean_ms(early.to_correct) - mean_ms(full.to_correct));
+    printf("acuracia do primeiro rotulo: %.1f%% -> %.1f%%\n", 100.0 * full.first_hits / full.boots,
+           100.0 * early.first_hits / early.boots);
+    return 0;
+}
@@ -0,0 +1,229 @@
+// Compara os backends de inferência na reprodução offline de data/*.csv:
+// acurácia, tempo e ciclos por janela e flash/RAM de cada modelo.
+//
+//   backend_compare [-r repeticoes] [-v fracao_validacao] [arquivo.csv ...]
+//
+// Todas as janelas (salto de 1 amostra) passam pelo extrator int8 do
+// firmware uma vez; depois cada backend roda sobre o mesmo lote -r vezes e
+// fica a melhor passada. "validacao" é o trecho final de cada gravação que
+// host/build/forest_train deixa fora do treino (mesmo -v); "todas" inclui
+// o trecho de treino da floresta e é otimista para ela.
+//
+// mlp é o kernel de model_mlp.h (bit a bit igual ao TFLM, ver
+// mlp_exact_check); forest é model_forest.h; tflm só aparece com
+// DEPLOY_TFLM_DIR. Ciclos são do TSC no x86 (ciclos de referência, não do
+// RP2040). Flash conta só os dados do modelo; o código do interpretador do
+// TFLM fica de fora. Retorna 1 se a floresta não usar a mesma quantização de
+// entrada do MLP (forest.json de outro model.h: treinar de novo).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define COMPARE_HAVE_TSC 1
+#else
+#define COMPARE_HAVE_TSC 0
+#endif
+
+#include "include/ai_core.h"
+#include "include/window_scheduler.h"
+#include "model.h"
+#include "model_forest.h"
+#include "model_mlp.h"
+#include "recording.h"
+
+#if COMPARE_TFLM
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+    uint8_t tensor_arena[12 * 1024];
+}
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Batch {
+    std::vector<int8_t> x;   // janelas x NUM_FEATURES
+    std::vector<int8_t> label;
+    std::vector<uint8_t> valid;
+    size_t size() const { return label.size(); }
+};
+
+struct Report {
+    const char *name = "";
+    long hits = 0, valid_hits = 0;
+    double ns = 0, cycles = 0;
+    size_t flash = 0, ram = 0;
+};
+
+static const char *class_names[NUM_CLASSES] = { "caminhando", "correndo", "parado", "pulando" };
+
+static int label_of(const char *name) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        if (strncmp(name, class_names[c], strlen(class_names[c])) == 0) return c;
+    }
+    return -1;
+}
+
+static uint64_t cycles_now() {
+#if COMPARE_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int argmax(const int8_t *v) {
+    int best = 0;
+    for (int c = 1; c < NUM_CLASSES; c++) {
+        if (v[c] > v[best]) best = c;
+    }
+    return best;
+}
+
+// Melhor de `repeats` passadas sobre o lote; acurácia da última
+template <typename Invoke>
+static void run(const Batch &b, int repeats, Invoke invoke, Report *r) {
+    std::vector<int8_t> out(b.size() * NUM_CLASSES);
+    r->ns = r->cycles = 1e300;
+    for (int k = 0; k < repeats; k++) {
+        Clock::time_point t0 = Clock::now();
+        uint64_t c0 = cycles_now();
+        for (size_t i = 0; i < b.size(); i++) invoke(&b.x[i * NUM_FEATURES], &out[i * NUM_CLASSES]);
+        uint64_t c1 = cycles_now();
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        r->ns = std::min(r->ns, ns / b.size());
+        r->cycles = std::min(r->cycles, (double)(c1 - c0) / b.size());
+    }
+    r->hits = r->valid_hits = 0;
+    for (size_t i = 0; i < b.size(); i++) {
+        bool hit = argmax(&out[i * NUM_CLASSES]) == b.label[i];
+        r->hits += hit;
+        r->valid_hits += hit && b.valid[i];
+    }
+}
+
+int main(int argc, char **argv) {
+    int repeats = 20;
+    double holdout = 0.25;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) holdout = atof(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    if (repeats < 1) repeats = 1;
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+    if (model_forest::kInputScale != model_mlp::kInputScale ||
+        model_forest::kInputZeroPoint != model_mlp::kInputZeroPoint) {
+        fprintf(stderr, "model_forest.h foi treinado com outra quantizacao de entrada: rode forest_train "
+                        "e gen_forest.py de novo\n");
+        return 1;
+    }
+
+    // Mesma divisão que forest_train
+    Batch batch;
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            return 2;
+        }
+        int label = label_of(rec.label);
+        if (label < 0) {
+            fprintf(stderr, "%s: classe desconhecida\n", rec.label);
+            return 2;
+        }
+        size_t split = (size_t)((double)rec.count * (1.0 - holdout));
+
+        static WindowScheduler sched;
+        scheduler_init(&sched, 1);
+        for (size_t i = 0; i < rec.count; i++) {
+            if (!scheduler_add_sample(&sched, &rec.rows[i][0], &rec.rows[i][3])) continue;
+            if (i >= split && i < split + WINDOW_SIZE) continue;
+            batch.x.resize(batch.x.size() + NUM_FEATURES);
+            extract_features_int8(&sched.win, ai_input_quant(), &batch.x[batch.x.size() - NUM_FEATURES]);
+            batch.label.push_back((int8_t)label);
+            batch.valid.push_back(i >= split);
+        }
+        recording_free(&rec);
+    }
+    long valid_total = std::count(batch.valid.begin(), batch.valid.end(), 1);
+    if (batch.size() == 0) return 2;
+
+    std::vector<Report> reports;
+
+    Report mlp_r;
+    mlp_r.name = "mlp";
+    model_mlp::Scratch scratch;
+    run(batch, repeats, [&](const int8_t *in, int8_t *out) { model_mlp::invoke(in, out, scratch); }, &mlp_r);
+    mlp_r.flash = sizeof(model_mlp::kDense0) + sizeof(model_mlp::kDense1) + sizeof(model_mlp::kDense2) +
+                  sizeof(model_mlp::kSoftmax);
+    mlp_r.ram = model_mlp::kInputSize + model_mlp::kOutputSize + sizeof(model_mlp::Scratch);
+    reports.push_back(mlp_r);
+
+    Report forest_r;
+    forest_r.name = "forest";
+    run(batch, repeats, [](const int8_t *in, int8_t *out) { model_forest::invoke(in, out); }, &forest_r);
+    forest_r.flash = sizeof(model_forest::kForest);
+    forest_r.ram = model_forest::kInputSize + model_forest::kOutputSize;
+    reports.push_back(forest_r);
+
+#if COMPARE_TFLM
+    const tflite::Model *model = tflite::GetModel(model_data);
+    static tflite::MicroMutableOpResolver<4> resolver;
+    resolver.AddFullyConnected();
+    resolver.AddRelu();
+    resolver.AddSoftmax();
+    resolver.AddQuantize();
+    static tflite::MicroInterpreter interpreter(model, resolver, tensor_arena, sizeof(tensor_arena));
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        fprintf(stderr, "AllocateTensors falhou\n");
+        return 2;
+    }
+    int8_t *tflm_in = interpreter.input(0)->data.int8;
+    const int8_t *tflm_out = interpreter.output(0)->data.int8;
+
+    Report tflm_r;
+    tflm_r.name = "tflm";
+    run(batch, repeats, [&](const int8_t *in, int8_t *out) {
+        memcpy(tflm_in, in, NUM_FEATURES);
+        interpreter.Invoke();
+        memcpy(out, tflm_out, NUM_CLASSES);
+    }, &tflm_r);
+    tflm_r.flash = sizeof(model_data);
+    tflm_r.ram = interpreter.arena_used_bytes();
+    reports.push_back(tflm_r);
+#endif
+
+    printf("janelas: %zu (%ld de validacao) | melhor de %d passadas\n\n", batch.size(), valid_total, repeats);
+    printf("%-8s %9s %10s %12s %15s %14s %8s\n", "backend", "todas", "validacao", "ns/janela",
+           "ciclos/janela", "flash (dados)", "RAM");
+    for (const Report &r : reports) {
+        char cycles[24] = "-";
+        if (COMPARE_HAVE_TSC) snprintf(cycles, sizeof(cycles), "%.0f", r.cycles);
+        printf("%-8s %8.2f%% %9.2f%% %12.1f %15s %14zu %8zu\n", r.name, 100.0 * r.hits / batch.size(),
+               valid_total ? 100.0 * r.valid_hits / valid_total : 0.0, r.ns, cycles, r.flash, r.ram);
+    }
+#if !COMPARE_TFLM
+    printf("%-8s %9s %10s %12s %15s %14zu %8s (sem TFLM: mesmas saidas do mlp)\n", "tflm", "-", "-", "-", "-",
+           sizeof(model_data), "-");
+#endif
+    printf("\nforest: %d arvores de profundidade %d\n", model_forest::kTrees, model_forest::kDepth);
+    return 0;
+}
@@ -0,0 +1,320 @@
+// Avaliação offline do que o firmware realmente calcula: features.c +
+// backend de inferência do build, sobre gravações CSV, em várias threads.
+//
+//   batch_eval [-j threads] [-s stride] [-r repeticoes] [-g [-v fracao_validacao]]
+//              [arquivo.csv|.imuc ...]
+//
+// Sem arquivos, usa data/*.csv. A classe verdadeira vem do nome do arquivo
+// (prefixo "caminhando", "correndo", "parado" ou "pulando"). WINDOW_SIZE é
+// fixo no build (-DEVAL_WINDOW_SIZE no CMake); o salto entre janelas é -s.
+//
+// Cada trecho de janelas consecutivas de um arquivo é uma tarefa; as threads
+// pegam tarefas de um contador atômico, cada uma com sua instância do modelo
+// (interpretador + arena próprios) e sua matriz de confusão.
+//
+// Toda janela também passa pelo gate de movimento (src/motion_gate.c), e o
+// relatório compara o modelo sozinho com a cascata gate -> modelo: acurácia
+// e inferências evitadas. Com -g, os limiares do gate são calibrados no
+// início de cada gravação (MOTION_GATE_MARGIN_PCT do menor valor de cada
+// estatística nas janelas que não são "parado") e impressos para config.h;
+// o relatório passa a cobrir só o trecho final (fração -v, a mesma divisão
+// de forest_train e backend_compare, separada por WINDOW_SIZE amostras).
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "include/ai_core.h"
+#include "include/window_scheduler.h"
+#include "include/motion_gate.h"
+#include "imu_columns.h"
+
+// Janelas por tarefa: grande o bastante para diluir o aquecimento da janela
+#define EVAL_CHUNK_WINDOWS 256
+
+typedef struct {
+    const imucol::ColumnFile *rec;
+    int label;
+    size_t first_end;   // índice da última amostra da primeira janela
+    int windows;
+} EvalTask;
+
+typedef struct {
+    long confusion[NUM_CLASSES][NUM_CLASSES];   // [verdadeira][prevista]
+    long cascade[NUM_CLASSES][NUM_CLASSES];     // gate -> modelo
+    long errors;
+    long gated[NUM_CLASSES];   // janelas decididas pelo gate, por classe verdadeira
+    double infer_ns;  // tempo dentro do modelo
+} EvalResult;
+
+static int label_of(const char *name) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        const char *cls = ai_class_name((ai_class_t)c);
+        if (strncmp(name, cls, strlen(cls)) == 0) return c;
+    }
+    return -1;
+}
+
+// Percorre as janelas da tarefa; visit(features Q8) a cada janela disparada
+template <class F>
+static void for_each_window(const EvalTask &t, int stride, WindowScheduler *sched, F &&visit) {
+    // Aquece a janela com as WINDOW_SIZE - 1 amostras anteriores
+    scheduler_init(sched, stride);
+    size_t start = t.first_end + 1 - WINDOW_SIZE;
+    size_t end = t.first_end + (size_t)(t.windows - 1) * stride;
+    imucol::WindowView span = t.rec->window(start, end + 1 - start);
+
+    for (size_t i = 0; i < span.length; i++) {
+        int16_t accel[3], gyro[3];
+        span.sample(i, accel, gyro);
+        if (!scheduler_add_sample(sched, accel, gyro)) continue;
+
+        int32_t features[NUM_FEATURES];
+        extract_features_q(&sched->win, features);
+        visit(features);
+    }
+}
+
+static void run_task(const EvalTask &t, int stride, ai_backend_t *model, MotionGate *gate,
+                     WindowScheduler *sched, EvalResult *res) {
+    for_each_window(t, stride, sched, [&](const int32_t *features) {
+        bool still = motion_gate_is_still(gate, features);
+
+        // O modelo roda sempre, para comparar com e sem o gate
+        auto t0 = std::chrono::steady_clock::now();
+        features_quantize_int8(features, ai_input_quant(), ai_instance_input(model));
+        ai_result_t r = ai_classify_instance(model);
+        res->infer_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        if (r.cls == AI_ERRO) {
+            res->errors++;
+            return;
+        }
+        res->confusion[t.label][r.cls]++;
+        res->cascade[t.label][still ? AI_PARADO : r.cls]++;
+        res->gated[t.label] += still;
+    });
+}
+
+// Tarefas de EVAL_CHUNK_WINDOWS janelas terminando de first_end a last_end
+// (inclusive), com salto stride; devolve o número de janelas
+static long add_tasks(const imucol::ColumnFile *rec, int label, size_t first_end, size_t last_end, int stride,
+                      std::vector<EvalTask> *tasks) {
+    if (last_end < first_end) return 0;
+    long n = (long)(last_end - first_end) / stride + 1;
+    for (long w = 0; w < n; w += EVAL_CHUNK_WINDOWS) {
+        EvalTask t;
+        t.rec = rec;
+        t.label = label;
+        t.first_end = first_end + (size_t)w * stride;
+        t.windows = (int)(n - w < EVAL_CHUNK_WINDOWS ? n - w : EVAL_CHUNK_WINDOWS);
+        tasks->push_back(t);
+    }
+    return n;
+}
+
+// Limiares: margem sobre o menor valor de cada estatística fora de "parado"
+static MotionGateThresholds calibrate_gate(const std::vector<EvalTask> &tasks, int stride) {
+    int32_t min_accel = INT32_MAX, min_gyro = INT32_MAX;
+    WindowScheduler *sched = new WindowScheduler;
+    for (const EvalTask &t : tasks) {
+        if (t.label == AI_PARADO) continue;
+        for_each_window(t, stride, sched, [&](const int32_t *features) {
+            int32_t accel, gyro;
+            motion_gate_stats(features, &accel, &gyro);
+            if (accel < min_accel) min_accel = accel;
+            if (gyro < min_gyro) min_gyro = gyro;
+        });
+    }
+    delete sched;
+
+    MotionGateThresholds th;
+    th.accel_std_q8 = (int32_t)((int64_t)min_accel * MOTION_GATE_MARGIN_PCT / 100);
+    th.gyro_std_q8 = (int32_t)((int64_t)min_gyro * MOTION_GATE_MARGIN_PCT / 100);
+    printf("calibracao do gate (menor em movimento: accel %d, gyro %d Q8; margem %d%%):\n"
+           "#define MOTION_GATE_ACCEL_STD_Q8 %d\n#define MOTION_GATE_GYRO_STD_Q8 %d\n\n",
+           min_accel, min_gyro, MOTION_GATE_MARGIN_PCT, th.accel_std_q8, th.gyro_std_q8);
+    return th;
+}
+
+int main(int argc, char **argv) {
+    int threads = (int)std::thread::hardware_concurrency();
+    int stride = WINDOW_HOP;
+    int repeats = 1;
+    bool calibrate = false;
+    double holdout = 0.25;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) stride = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-g") == 0) calibrate = true;
+        else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) holdout = atof(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    if (threads < 1) threads = 1;
+    if (stride < 1) stride = 1;
+    if (repeats < 1) repeats = 1;
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+
+    /* ---------- Gravações e tarefas ---------- */
+    std::vector<imucol::ColumnFile> recs(files.size());
+    std::vector<EvalTask> tasks, calib_tasks;
+    long total_windows = 0;
+
+    for (size_t k = 0; k < files.size(); k++) {
+        if (!recs[k].open(files[k])) {
+            fprintf(stderr, "%s\n", recs[k].error().c_str());
+            return 2;
+        }
+        int label = label_of(recs[k].label().c_str());
+        if (label < 0) {
+            fprintf(stderr, "%s: classe desconhecida, ignorado\n", files[k]);
+            continue;
+        }
+        if (recs[k].size() < WINDOW_SIZE) continue;
+
+        // Com -g: calibração nas janelas que terminam antes de split e
+        // relatório nas que começam depois dele
+        size_t first = WINDOW_SIZE - 1, last = recs[k].size() - 1;
+        if (calibrate) {
+            size_t split = (size_t)((double)recs[k].size() * (1.0 - holdout));
+            if (split > first) add_tasks(&recs[k], label, first, split - 1, stride, &calib_tasks);
+            first = split + WINDOW_SIZE;
+        }
+        total_windows += add_tasks(&recs[k], label, first, last, stride, &tasks);
+    }
+    if (calibrate && calib_tasks.empty()) {
+        fprintf(stderr, "gravacoes curtas demais para calibrar com -v %.2f\n", holdout);
+        return 2;
+    }
+
+    MotionGate gate_config;
+    motion_gate_init(&gate_config, NULL);
+    MotionGateThresholds gate_th = calibrate ? calibrate_gate(calib_tasks, stride) : gate_config.th;
+
+    /* ---------- Workers ---------- */
+    std::vector<EvalResult> results(threads, EvalResult{});
+    std::atomic<size_t> next{0};
+    size_t total_tasks = tasks.size() * repeats;
+    std::atomic<bool> instance_failed{false};
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int w = 0; w < threads; w++) {
+        pool.emplace_back([&, w] {
+            ai_backend_t *model = ai_instance_create();
+            if (model == nullptr) {
+                instance_failed = true;
+                return;
+            }
+            WindowScheduler *sched = new WindowScheduler;
+            MotionGate gate;
+            motion_gate_init(&gate, &gate_th);
+            EvalResult local;   // local para não disputar linhas de cache
+            memset(&local, 0, sizeof(local));
+
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < total_tasks;) {
+                run_task(tasks[i % tasks.size()], stride, model, &gate, sched, &local);
+            }
+            results[w] = local;
+            delete sched;
+            ai_instance_destroy(model);
+        });
+    }
+    for (std::thread &t : pool) t.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (instance_failed) {
+        fprintf(stderr, "falha ao criar instancia do modelo\n");
+        return 2;
+    }
+
+    /* ---------- Relatório ---------- */
+    EvalResult sum;
+    memset(&sum, 0, sizeof(sum));
+    for (const EvalResult &r : results) {
+        for (int a = 0; a < NUM_CLASSES; a++) {
+            for (int p = 0; p < NUM_CLASSES; p++) {
+                sum.confusion[a][p] += r.confusion[a][p];
+                sum.cascade[a][p] += r.cascade[a][p];
+            }
+        }
+        sum.errors += r.errors;
+        for (int a = 0; a < NUM_CLASSES; a++) sum.gated[a] += r.gated[a];
+        sum.infer_ns += r.infer_ns;
+    }
+    // Com -r, as matrizes mostram uma passada só
+    for (int a = 0; a < NUM_CLASSES; a++) {
+        for (int p = 0; p < NUM_CLASSES; p++) {
+            sum.confusion[a][p] /= repeats;
+            sum.cascade[a][p] /= repeats;
+        }
+        sum.gated[a] /= repeats;
+    }
+
+    printf("janelas: %ld%s | WINDOW_SIZE: %d | stride: %d | threads: %d\n", total_windows,
+           calibrate ? " (validacao)" : "", WINDOW_SIZE, stride, threads);
+    printf("\n%-12s", "real\\prev");
+    for (int p = 0; p < NUM_CLASSES; p++) printf(" %11s", ai_class_name((ai_class_t)p));
+    printf("\n");
+    long correct = 0, counted = 0;
+    for (int a = 0; a < NUM_CLASSES; a++) {
+        printf("%-12s", ai_class_name((ai_class_t)a));
+        for (int p = 0; p < NUM_CLASSES; p++) {
+            printf(" %11ld", sum.confusion[a][p]);
+            counted += sum.confusion[a][p];
+        }
+        correct += sum.confusion[a][a];
+        printf("\n");
+    }
+
+    printf("\n%-12s %9s %9s %9s %8s\n", "classe", "precisao", "recall", "f1", "janelas");
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        long tp = sum.confusion[c][c], pred = 0, real = 0;
+        for (int k = 0; k < NUM_CLASSES; k++) {
+            pred += sum.confusion[k][c];
+            real += sum.confusion[c][k];
+        }
+        double precision = pred > 0 ? (double)tp / pred : 0.0;
+        double recall = real > 0 ? (double)tp / real : 0.0;
+        double f1 = precision + recall > 0 ? 2 * precision * recall / (precision + recall) : 0.0;
+        printf("%-12s %9.3f %9.3f %9.3f %8ld\n", ai_class_name((ai_class_t)c), precision, recall, f1, real);
+    }
+
+    printf("\nacuracia: %.4f", counted > 0 ? (double)correct / counted : 0.0);
+    if (sum.errors > 0) printf(" | erros de inferencia: %ld", sum.errors);
+    printf("\n%.3f s | %.0f janelas/s\n", secs, total_windows * repeats / secs);
+
+    /* ---------- Cascata gate -> modelo ---------- */
+    long cascade_correct = 0, gated = 0, gated_moving = 0, real_parado = 0;
+    for (int a = 0; a < NUM_CLASSES; a++) {
+        cascade_correct += sum.cascade[a][a];
+        gated += sum.gated[a];
+        if (a != AI_PARADO) gated_moving += sum.gated[a];
+        real_parado += sum.confusion[AI_PARADO][a];
+    }
+    double infer_us = counted > 0 ? sum.infer_ns / 1000.0 / ((double)counted * repeats) : 0.0;
+    printf("\ngate de movimento (accel <= %d, gyro <= %d Q8):\n", gate_th.accel_std_q8, gate_th.gyro_std_q8);
+    printf("  %ld de %ld janelas sem inferencia (%.1f%%) | %.1f%% das janelas paradas | %ld em movimento\n",
+           gated, counted, counted > 0 ? 100.0 * gated / counted : 0.0,
+           real_parado > 0 ? 100.0 * sum.gated[AI_PARADO] / real_parado : 0.0, gated_moving);
+    printf("  acuracia: modelo %.4f | cascata %.4f\n", counted > 0 ? (double)correct / counted : 0.0,
+           counted > 0 ? (double)cascade_correct / counted : 0.0);
+    printf("  modelo no host: %.2f us/janela | evitado: %.1f ms de %.1f ms\n", infer_us,
+           gated * infer_us / 1000.0, counted * infer_us / 1000.0);
+
+    return 0;
+}
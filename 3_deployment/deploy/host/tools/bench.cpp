@@ -0,0 +1,531 @@
+// Microbenchmarks do caminho quente (janela, features, espectro e
+// inferência) sobre janelas reais de data/*.csv, com saída em JSON e
+// comparação com uma linha de base versionada.
+//
+//   bench [-o resultado.json] [-b linha_de_base.json] [-t tol_razao] [-i tol_instr]
+//         [-f filtro] [arquivo.csv ...]
+//
+// ns/op: a melhor de BENCH_RUNS rodadas de pelo menos BENCH_MIN_NS cada (o
+// mínimo varia bem menos que a mediana numa máquina compartilhada); as
+// rodadas passam por todos os benchmarks em sequência.
+// allocs/op: malloc/calloc/realloc (ligados com -Wl,--wrap no Linux) e
+// operator new durante uma rodada. instr/op: instruções em modo usuário
+// pelo perf_event_open, quando o kernel deixa (senão null).
+//
+// calibration_ns: ns/op de um laço fixo sobre as amostras, medido no mesmo
+// processo, nas mesmas rodadas dos benchmarks; ns/op dividido por ele
+// é a razão, que não depende da velocidade da máquina nem da frequência do
+// momento.
+//
+// Com -b, cada benchmark é comparado pelo nome: falha se alocar mais que a
+// base ou se ficar mais lento que base * (1 + tolerância), em instruções/op
+// quando as duas medições têm esse contador (mais estável) ou na razão com
+// a calibração. ns/op cru nunca é comparado: uma base sem calibração só
+// confere alocações. Saída 1 em regressão; `cmake --build ... --target
+// bench_check` roda isso contra host/bench_baseline.json. Antes de acusar
+// lentidão, os benchmarks acima da tolerância (e a calibração) ganham até
+// BENCH_RETRIES séries extras de rodadas: ruído da máquina passa, regressão
+// real não.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "include/ai_core.h"
+#include "include/features.h"
+#include "include/spectral.h"
+#include "recording.h"
+
+#define BENCH_RUNS 9
+#define BENCH_MIN_NS 20000000.0
+#define BENCH_CALIBRATION_STEPS 256
+#define BENCH_RETRIES 2
+
+extern "C" {
+#if !FEATURES_FIXED_POINT
+float bench_calc_std(const WindowBuffer *win, int ch);
+float bench_calc_range(const WindowBuffer *win, int ch);
+float bench_calc_zcr(const WindowBuffer *win, int ch);
+#endif
+int32_t bench_calc_std_q(const WindowBuffer *win, int ch);
+}
+
+/* ---------- Contagem de alocações ---------- */
+
+static long g_allocs = 0;
+
+#if BENCH_WRAP_MALLOC
+extern "C" {
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t n);
+
+void *__wrap_malloc(size_t n) {
+    g_allocs++;
+    return __real_malloc(n);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+    g_allocs++;
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, size_t n) {
+    g_allocs++;
+    return __real_realloc(p, n);
+}
+}
+#endif
+
+void *operator new(size_t n) {
+    g_allocs++;
+    void *p = std::malloc(n ? n : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+/* ---------- Contador de instruções ---------- */
+
+class InstructionCounter {
+public:
+    InstructionCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~InstructionCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    bool available() const { return fd_ >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+/* ---------- Medição ---------- */
+
+struct BenchResult {
+    std::string name;
+    double ns_per_op;
+    double allocs_per_op;
+    double instr_per_op;   // < 0: indisponível
+};
+
+static volatile float g_sink;
+
+// Laço fixo parecido com o caminho quente: soma de quadrados de
+// BENCH_CALIBRATION_STEPS amostras int16 das gravações (memória em cache) e
+// uma raiz/divisão em float por bloco de 16
+static float calibration_op(const int16_t *data, size_t count, long i) {
+    size_t start = (size_t)i * 61 % (count - BENCH_CALIBRATION_STEPS);
+    const int16_t *p = data + start;
+    int64_t acc = 0;
+    float f = 1.0f;
+    for (int k = 0; k < BENCH_CALIBRATION_STEPS; k++) {
+        acc += (int32_t)p[k] * p[k];
+        if ((k & 15) == 15) f = sqrtf((float)acc + f) / 3.0f;
+    }
+    return f;
+}
+
+static double now_ns() {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Benchmark registrado: loop(n) roda n operações e devolve o tempo em ns
+struct Bench {
+    std::string name;
+    std::function<double(long)> loop;
+    long n = 1;
+    BenchResult res;
+};
+
+// op(i) executa uma operação; i percorre as janelas/amostras de entrada
+template <class F>
+static Bench make_bench(const char *name, F op) {
+    Bench b;
+    b.name = name;
+    b.loop = [op](long n) mutable {
+        double t0 = now_ns();
+        for (long i = 0; i < n; i++) g_sink = op(i);
+        return now_ns() - t0;
+    };
+    return b;
+}
+
+static void measure_rounds(const std::vector<Bench *> &benches) {
+    for (int r = 0; r < BENCH_RUNS; r++) {
+        for (Bench *b : benches) b->res.ns_per_op = std::min(b->res.ns_per_op, b->loop(b->n) / b->n);
+    }
+}
+
+// Rodadas intercaladas: cada rodada passa uma vez por todos os benchmarks,
+// então uma fase lenta da máquina atinge todos (e a calibração) em vez de
+// todas as rodadas de um só; fica o mínimo de cada um
+static void measure_all(std::vector<Bench> &benches, InstructionCounter &counter) {
+    for (Bench &b : benches) {
+        // Operações por rodada
+        for (b.n = 1; b.loop(b.n) < BENCH_MIN_NS && b.n < (1l << 30); b.n *= 2) {}
+        b.res.name = b.name;
+        b.res.ns_per_op = 1e300;
+
+        long a0 = g_allocs;
+        counter.start();
+        b.loop(b.n);
+        long long instr = counter.stop();
+        b.res.allocs_per_op = (double)(g_allocs - a0) / b.n;
+        b.res.instr_per_op = instr >= 0 ? (double)instr / b.n : -1.0;
+    }
+    std::vector<Bench *> all;
+    for (Bench &b : benches) all.push_back(&b);
+    measure_rounds(all);
+}
+
+/* ---------- JSON ---------- */
+
+static bool write_json(const char *path, double calibration_ns, const std::vector<BenchResult> &results) {
+    FILE *fp = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (fp == NULL) return false;
+    fprintf(fp, "{\n  \"window_size\": %d,\n  \"features_fixed_point\": %d,\n  \"calibration_ns\": %.2f,\n"
+                "  \"benchmarks\": [\n",
+            WINDOW_SIZE, FEATURES_FIXED_POINT, calibration_ns);
+    for (size_t k = 0; k < results.size(); k++) {
+        const BenchResult &r = results[k];
+        char instr[32];
+        if (r.instr_per_op >= 0) snprintf(instr, sizeof(instr), "%.1f", r.instr_per_op);
+        else snprintf(instr, sizeof(instr), "null");
+        fprintf(fp, "    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"instructions_per_op\": %s}%s\n",
+                r.name.c_str(), r.ns_per_op, r.allocs_per_op, instr, k + 1 < results.size() ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    return fp == stdout || fclose(fp) == 0;
+}
+
+// Lê o formato que write_json escreve: um benchmark por linha;
+// *calibration_ns fica 0 em bases antigas, sem o campo
+static bool read_json(const char *path, double *calibration_ns, std::vector<BenchResult> *out) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) return false;
+    char line[512];
+    *calibration_ns = 0.0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        const char *cal = strstr(line, "\"calibration_ns\": ");
+        if (cal != NULL) *calibration_ns = atof(cal + 18);
+        const char *p = strstr(line, "\"name\": \"");
+        if (p == NULL) continue;
+        p += 9;
+        const char *end = strchr(p, '"');
+        const char *ns = strstr(line, "\"ns_per_op\": ");
+        const char *al = strstr(line, "\"allocs_per_op\": ");
+        const char *in = strstr(line, "\"instructions_per_op\": ");
+        if (end == NULL || ns == NULL || al == NULL || in == NULL) continue;
+
+        BenchResult r;
+        r.name.assign(p, end);
+        r.ns_per_op = atof(ns + 13);
+        r.allocs_per_op = atof(al + 17);
+        r.instr_per_op = strncmp(in + 23, "null", 4) == 0 ? -1.0 : atof(in + 23);
+        out->push_back(r);
+    }
+    fclose(fp);
+    return true;
+}
+
+// Falhas em *slow (lentidão, que pode ser ruído) e no retorno (lentidão ou
+// alocação); com print, imprime a tabela
+static bool compare(const std::vector<BenchResult> &cur, double cur_cal, const std::vector<BenchResult> &base,
+                    double base_cal, double tol_ns, double tol_instr, bool print,
+                    std::vector<std::string> *slow) {
+    bool ok = true;
+    bool by_ratio = cur_cal > 0 && base_cal > 0;
+    slow->clear();
+    if (print && !by_ratio) printf("\nbase sem calibration_ns: tempo nao comparado, so alocacoes (regrave a base)\n");
+    if (print) printf("\n%-24s %12s %12s %8s  %s\n", "benchmark", "atual", "base", "delta", "");
+    for (const BenchResult &c : cur) {
+        const BenchResult *b = nullptr;
+        for (const BenchResult &x : base) {
+            if (x.name == c.name) b = &x;
+        }
+        if (b == nullptr) {
+            if (print) printf("%-24s %12.2f %12s %8s  novo\n", c.name.c_str(), c.ns_per_op, "-", "");
+            continue;
+        }
+
+        bool by_instr = c.instr_per_op >= 0 && b->instr_per_op > 0;
+        double now = by_instr ? c.instr_per_op : by_ratio ? c.ns_per_op / cur_cal : c.ns_per_op;
+        double ref = by_instr ? b->instr_per_op : by_ratio ? b->ns_per_op / base_cal : b->ns_per_op;
+        double tol = by_instr ? tol_instr : tol_ns;
+        double delta = ref > 0 ? now / ref - 1.0 : 0.0;
+        bool slower = (by_instr || by_ratio) && delta > tol;
+        bool allocs = c.allocs_per_op > b->allocs_per_op + 1e-6;
+
+        const char *status = slower ? "MAIS LENTO" : allocs ? "ALOCA MAIS" : "ok";
+        if (print) {
+            printf("%-24s %12.3f %12.3f %+7.1f%%  %s (%s)\n", c.name.c_str(), now, ref, 100 * delta, status,
+                   by_instr ? "instr" : by_ratio ? "razao" : "ns, nao comparado");
+        }
+        if (slower && !by_instr) slow->push_back(c.name);
+        ok = ok && !slower && !allocs;
+    }
+    return ok;
+}
+
+/* ---------- Entradas ---------- */
+
+struct Inputs {
+    std::vector<int16_t> samples;        // [n][6], gravações concatenadas
+    std::vector<WindowBuffer> windows;   // janelas cheias a cada WINDOW_HOP
+    std::vector<float> features;         // [janela][NUM_FEATURES]
+    std::vector<int8_t> quantized;       // [janela][NUM_FEATURES]
+    std::vector<SpectralWindow> spectra; // cheias, no mesmo ritmo das janelas
+};
+
+static bool load_inputs(const std::vector<const char *> &files, Inputs *in) {
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            return false;
+        }
+        WindowBuffer win;
+        SpectralWindow sw;
+        window_init(&win);
+        spectral_init(&sw);
+        int since = 0, since_sw = 0;
+        for (size_t i = 0; i < rec.count; i++) {
+            in->samples.insert(in->samples.end(), rec.rows[i], rec.rows[i] + 6);
+            window_add_sample(&win, &rec.rows[i][0], &rec.rows[i][3]);
+            spectral_add_sample(&sw, &win);
+            if (window_is_ready(&win) && since++ % WINDOW_HOP == 0) in->windows.push_back(win);
+            if (spectral_is_ready(&sw) && since_sw++ % WINDOW_HOP == 0) in->spectra.push_back(sw);
+        }
+        recording_free(&rec);
+    }
+
+    for (WindowBuffer &w : in->windows) {
+        float f[NUM_FEATURES];
+        int8_t q[NUM_FEATURES];
+        extract_features(&w, f);
+        extract_features_int8(&w, ai_input_quant(), q);
+        in->features.insert(in->features.end(), f, f + NUM_FEATURES);
+        in->quantized.insert(in->quantized.end(), q, q + NUM_FEATURES);
+    }
+    return !in->windows.empty();
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = nullptr;
+    const char *baseline = nullptr;
+    const char *filter = nullptr;
+    double tol_ns = 0.30, tol_instr = 0.05;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) baseline = argv[++i];
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) tol_ns = atof(argv[++i]);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) tol_instr = atof(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) filter = argv[++i];
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+    Inputs in;
+    if (!load_inputs(files, &in)) return 2;
+
+    const size_t nw = in.windows.size();
+    const size_t ns = in.samples.size() / 6;
+    InstructionCounter counter;
+    std::vector<Bench> benches;
+    auto run = [&](const char *name, auto &&op) {
+        if (filter != nullptr && strstr(name, filter) == nullptr) return;
+        benches.push_back(make_bench(name, op));
+    };
+
+    printf("%zu janelas e %zu amostras de %zu arquivos | WINDOW_SIZE %d | contador de instrucoes: %s\n\n",
+           nw, ns, files.size(), WINDOW_SIZE, counter.available() ? "sim" : "indisponivel");
+
+    // Sempre, mesmo com -f
+    benches.push_back(make_bench("calibracao", [&](long i) {
+        return calibration_op(in.samples.data(), in.samples.size(), i);
+    }));
+
+    WindowBuffer sliding;
+    window_init(&sliding);
+    run("window_add_sample", [&](long i) {
+        int16_t *s = &in.samples[(size_t)(i % (long)ns) * 6];
+        window_add_sample(&sliding, &s[0], &s[3]);
+        return (float)sliding.sum[0];
+    });
+
+#if !FEATURES_FIXED_POINT
+    // calc_*: todos os canais de uma janela por operação (uma chamada só
+    // fica em poucos ns e o laço do benchmark pesa mais que a função)
+    run("calc_std", [&](long i) {
+        float acc = 0;
+        for (int ch = 0; ch < WINDOW_CHANNELS; ch++) acc += bench_calc_std(&in.windows[(size_t)i % nw], ch);
+        return acc;
+    });
+    run("calc_range", [&](long i) {
+        float acc = 0;
+        for (int ch = 0; ch < RANGE_CHANNELS; ch++) acc += bench_calc_range(&in.windows[(size_t)i % nw], ch);
+        return acc;
+    });
+    run("calc_zcr", [&](long i) {
+        float acc = 0;
+        for (int ch = 0; ch < RANGE_CHANNELS; ch++) acc += bench_calc_zcr(&in.windows[(size_t)i % nw], ch);
+        return acc;
+    });
+#endif
+    run("calc_std_q", [&](long i) {
+        int32_t acc = 0;
+        for (int ch = 0; ch < WINDOW_CHANNELS; ch++) acc += bench_calc_std_q(&in.windows[(size_t)i % nw], ch);
+        return (float)acc;
+    });
+
+    run("extract_features", [&](long i) {
+        float f[NUM_FEATURES];
+        extract_features(&in.windows[(size_t)i % nw], f);
+        return f[0];
+    });
+    run("extract_features_q", [&](long i) {
+        int32_t q[NUM_FEATURES];
+        extract_features_q(&in.windows[(size_t)i % nw], q);
+        return (float)q[0];
+    });
+    run("extract_features_int8", [&](long i) {
+        extract_features_int8(&in.windows[(size_t)i % nw], ai_input_quant(), ai_input_buffer());
+        return (float)ai_input_buffer()[0];
+    });
+
+    if (!in.spectra.empty()) {
+        run("spectral_extract_q", [&](long i) {
+            int32_t q[SPECTRAL_NUM_FEATURES];
+            spectral_extract_q(&in.spectra[(size_t)i % in.spectra.size()], q);
+            return (float)q[0];
+        });
+    }
+
+    run("ai_run_inference", [&](long i) {
+        float conf;
+        const char *cls = ai_run_inference(&in.features[((size_t)i % nw) * NUM_FEATURES], &conf);
+        return conf + (float)cls[0];
+    });
+    run("ai_classify", [&](long i) {
+        memcpy(ai_input_buffer(), &in.quantized[((size_t)i % nw) * NUM_FEATURES], NUM_FEATURES);
+        ai_result_t r = ai_classify();
+        return (float)r.confidence;
+    });
+    run("ai_init", [&](long) { return ai_init() ? 1.0f : 0.0f; });
+
+    measure_all(benches, counter);
+    double calibration_ns = 0.0;
+    std::vector<BenchResult> results;
+    auto collect = [&] {
+        results.clear();
+        for (const Bench &b : benches) {
+            if (b.name == "calibracao") calibration_ns = b.res.ns_per_op;
+            else results.push_back(b.res);
+        }
+    };
+    collect();
+    for (const Bench &b : benches) {
+        const BenchResult &r = b.res;
+        printf("%-24s %10.2f ns/op %8.3f allocs/op", r.name.c_str(), r.ns_per_op, r.allocs_per_op);
+        if (r.instr_per_op >= 0) printf(" %10.1f instr/op", r.instr_per_op);
+        printf("\n");
+    }
+
+    bool ok = true;
+    if (out_path != nullptr && !write_json(out_path, calibration_ns, results)) {
+        fprintf(stderr, "nao foi possivel escrever %s\n", out_path);
+        ok = false;
+    }
+    if (baseline != nullptr) {
+        std::vector<BenchResult> base;
+        double base_cal;
+        if (!read_json(baseline, &base_cal, &base)) {
+            fprintf(stderr, "nao foi possivel ler %s\n", baseline);
+            return 2;
+        }
+        std::vector<std::string> slow;
+        for (int k = 0; k < BENCH_RETRIES; k++) {
+            compare(results, calibration_ns, base, base_cal, tol_ns, tol_instr, false, &slow);
+            if (slow.empty()) break;
+            std::vector<Bench *> again;
+            printf("\nacima da tolerancia, medindo de novo:");
+            for (Bench &b : benches) {
+                bool listed = std::find(slow.begin(), slow.end(), b.name) != slow.end();
+                if (listed) printf(" %s", b.name.c_str());
+                if (listed || b.name == "calibracao") again.push_back(&b);
+            }
+            printf("\n");
+            measure_rounds(again);
+            collect();
+        }
+        bool cmp_ok = compare(results, calibration_ns, base, base_cal, tol_ns, tol_instr, true, &slow);
+        printf("%s (tolerancia %.0f%% na razao, %.0f%% em instrucoes)\n", cmp_ok ? "OK" : "REGRESSAO",
+               100 * tol_ns, 100 * tol_instr);
+        ok = ok && cmp_ok;
+    }
+    return ok ? 0 : 1;
+}
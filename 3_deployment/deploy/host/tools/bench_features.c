@@ -0,0 +1,23 @@
+// Funções internas de features.c expostas para o bench: o arquivo é
+// incluído inteiro aqui (o alvo bench não compila features.c à parte), então
+// os static são medidos exatamente como o firmware os compila.
+
+#include "src/features.c"
+
+#if !FEATURES_FIXED_POINT
+float bench_calc_std(const WindowBuffer *win, int ch) {
+    return calc_std(win, ch);
+}
+
+float bench_calc_range(const WindowBuffer *win, int ch) {
+    return calc_range(win, ch);
+}
+
+float bench_calc_zcr(const WindowBuffer *win, int ch) {
+    return calc_zcr(win, ch);
+}
+#endif
+
+int32_t bench_calc_std_q(const WindowBuffer *win, int ch) {
+    return calc_std_q(win, ch);
+}
@@ -0,0 +1,224 @@
+// Confere features_batch (SoA, SSE4.1/AVX2/escalar) contra extract_features
+// de src/features.c e mede a vazão de cada ISA em uma thread.
+//
+//   features_batch_check [arquivo.csv ...]
+//
+// Equivalência bit a bit em todas as janelas (salto 1) de data/*.csv, em
+// janelas sintéticas com valores extremos e numa cauda que não completa um
+// grupo SIMD. O alvo compila features.c com FEATURES_FIXED_POINT=0, que é o
+// caminho que o lote reproduz.
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "include/features.h"
+#include "features_batch.h"
+#include "recording.h"
+
+#define SYNTH_WINDOWS 4099   // não múltiplo de 8: exercita a cauda escalar
+#define BENCH_MIN_NS 300000000ull
+
+static const char *feature_names[NUM_FEATURES] = {
+    "std_ax", "std_ay", "std_az", "std_gx", "std_gy", "std_gz",
+    "mag_accel", "mag_gyro", "range_ax", "range_ay", "range_az",
+    "zcr_ax", "zcr_ay", "zcr_az"
+};
+
+typedef struct {
+    int16_t *data;    // [WINDOW_CHANNELS][WINDOW_SIZE][stride]
+    float *ref;       // [count][NUM_FEATURES]
+    size_t count, stride;
+} Batch;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void batch_alloc(Batch *b, size_t count) {
+    b->count = count;
+    b->stride = (count + 7) / 8 * 8;
+    b->data = calloc((size_t)WINDOW_CHANNELS * WINDOW_SIZE * b->stride, sizeof(int16_t));
+    b->ref = calloc(count * NUM_FEATURES, sizeof(float));
+}
+
+static void batch_set(Batch *b, size_t w, int t, const int16_t *sample) {
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        b->data[((size_t)ch * WINDOW_SIZE + t) * b->stride + w] = sample[ch];
+    }
+}
+
+static FeatureBatch batch_view(const Batch *b) {
+    FeatureBatch fb = { b->data, b->count, b->stride, WINDOW_SIZE };
+    return fb;
+}
+
+// Janelas de salto 1 das gravações; referência pela janela deslizante do
+// firmware, alimentada amostra a amostra
+static void build_recorded(Batch *b, Recording *recs, int n_recs) {
+    size_t total = 0;
+    for (int r = 0; r < n_recs; r++) {
+        if (recs[r].count >= WINDOW_SIZE) total += recs[r].count - WINDOW_SIZE + 1;
+    }
+    batch_alloc(b, total);
+
+    size_t w = 0;
+    for (int r = 0; r < n_recs; r++) {
+        WindowBuffer win;
+        window_init(&win);
+        for (size_t i = 0; i < recs[r].count; i++) {
+            int16_t *row = recs[r].rows[i];
+            window_add_sample(&win, &row[0], &row[3]);
+            if (!window_is_ready(&win)) continue;
+            for (int t = 0; t < WINDOW_SIZE; t++) batch_set(b, w, t, recs[r].rows[i + 1 - WINDOW_SIZE + t]);
+            extract_features(&win, &b->ref[w * NUM_FEATURES]);
+            w++;
+        }
+    }
+}
+
+// Ruído, constantes, fundo de escala e alternância entre extremos
+static void build_synthetic(Batch *b) {
+    batch_alloc(b, SYNTH_WINDOWS);
+    uint32_t seed = 12345;
+    for (size_t w = 0; w < b->count; w++) {
+        WindowBuffer win;
+        window_init(&win);
+        int kind = (int)(w % 5);
+        for (int t = 0; t < WINDOW_SIZE; t++) {
+            int16_t s[WINDOW_CHANNELS];
+            for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+                seed = seed * 1664525u + 1013904223u;
+                int16_t noise = (int16_t)(seed >> 16);
+                switch (kind) {
+                case 0: s[ch] = noise; break;
+                case 1: s[ch] = (int16_t)(noise >> 6); break;
+                case 2: s[ch] = (int16_t)(w % 3 == 0 ? INT16_MIN : w % 3 == 1 ? INT16_MAX : 0); break;
+                case 3: s[ch] = (t + ch) % 2 ? INT16_MAX : INT16_MIN; break;
+                default: s[ch] = (int16_t)((int)(w * 37 + ch * 1000) - 16384 + (noise >> 12)); break;
+                }
+            }
+            batch_set(b, w, t, s);
+            window_add_sample(&win, &s[0], &s[3]);
+        }
+        extract_features(&win, &b->ref[w * NUM_FEATURES]);
+    }
+}
+
+static bool compare(const char *what, const Batch *b, FeatureIsa isa) {
+    float *out = malloc(b->count * NUM_FEATURES * sizeof(float));
+    FeatureBatch fb = batch_view(b);
+    features_batch_extract(&fb, isa, out);
+
+    size_t bad = 0;
+    for (size_t w = 0; w < b->count; w++) {
+        for (int i = 0; i < NUM_FEATURES; i++) {
+            float got = out[w * NUM_FEATURES + i], want = b->ref[w * NUM_FEATURES + i];
+            if (memcmp(&got, &want, sizeof(float)) == 0) continue;
+            if (bad++ == 0) {
+                printf("  janela %zu %s: %.9g (esperado %.9g)\n", w, feature_names[i], got, want);
+            }
+        }
+    }
+    printf("%-8s %-10s %7zu janelas: %s", features_batch_isa_name(isa), what, b->count,
+           bad == 0 ? "OK\n" : "FALHOU");
+    if (bad != 0) printf(" (%zu features diferentes)\n", bad);
+    free(out);
+    return bad == 0;
+}
+
+// Janelas por segundo em uma thread
+static double bench_isa(const Batch *b, FeatureIsa isa) {
+    float *out = malloc(b->count * NUM_FEATURES * sizeof(float));
+    FeatureBatch fb = batch_view(b);
+    uint64_t t0 = now_ns(), elapsed;
+    size_t windows = 0;
+    do {
+        features_batch_extract(&fb, isa, out);
+        windows += b->count;
+        elapsed = now_ns() - t0;
+    } while (elapsed < BENCH_MIN_NS);
+    free(out);
+    return windows * 1e9 / elapsed;
+}
+
+// Referência: uma WindowBuffer nova por janela (window_add_sample x
+// WINDOW_SIZE + extract_features), como o featurize faz com salto grande
+static double bench_window_buffer(const Batch *b) {
+    volatile float sink = 0;
+    uint64_t t0 = now_ns(), elapsed;
+    size_t windows = 0;
+    do {
+        for (size_t w = 0; w < b->count; w++) {
+            WindowBuffer win;
+            float f[NUM_FEATURES];
+            window_init(&win);
+            for (int t = 0; t < WINDOW_SIZE; t++) {
+                int16_t s[WINDOW_CHANNELS];
+                for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+                    s[ch] = b->data[((size_t)ch * WINDOW_SIZE + t) * b->stride + w];
+                }
+                window_add_sample(&win, &s[0], &s[3]);
+            }
+            extract_features(&win, f);
+            sink = f[0];
+        }
+        windows += b->count;
+        elapsed = now_ns() - t0;
+    } while (elapsed < BENCH_MIN_NS);
+    (void)sink;
+    return windows * 1e9 / elapsed;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                               DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int n_files = argc > 1 ? argc - 1 : 4;
+
+    Recording *recs = calloc((size_t)n_files, sizeof(Recording));
+    int n_recs = 0;
+    for (int i = 0; i < n_files; i++) {
+        if (recording_load(files[i], &recs[n_recs])) n_recs++;
+        else fprintf(stderr, "nao foi possivel abrir %s\n", files[i]);
+    }
+
+    Batch recorded, synthetic;
+    build_recorded(&recorded, recs, n_recs);
+    build_synthetic(&synthetic);
+    printf("WINDOW_SIZE %d | melhor ISA: %s\n", WINDOW_SIZE, features_batch_isa_name(features_batch_best_isa()));
+
+    /* ---------- Equivalência ---------- */
+    bool ok = recorded.count > 0;
+    for (int isa = 0; isa < FEATURE_ISA_COUNT; isa++) {
+        if (!features_batch_isa_supported((FeatureIsa)isa)) {
+            printf("%-8s nao suportada nesta CPU\n", features_batch_isa_name((FeatureIsa)isa));
+            continue;
+        }
+        ok = compare("gravacoes", &recorded, (FeatureIsa)isa) && ok;
+        ok = compare("sinteticas", &synthetic, (FeatureIsa)isa) && ok;
+    }
+
+    /* ---------- Vazão por núcleo ---------- */
+    double base = bench_window_buffer(&recorded);
+    printf("\n%-22s %14s %8s\n", "", "janelas/s", "x");
+    printf("%-22s %14.0f %8.2f\n", "WindowBuffer + extract", base, 1.0);
+    for (int isa = 0; isa < FEATURE_ISA_COUNT; isa++) {
+        if (!features_batch_isa_supported((FeatureIsa)isa)) continue;
+        double rate = bench_isa(&recorded, (FeatureIsa)isa);
+        printf("lote %-17s %14.0f %8.2f\n", features_batch_isa_name((FeatureIsa)isa), rate, rate / base);
+    }
+
+    for (int i = 0; i < n_recs; i++) recording_free(&recs[i]);
+    free(recs);
+    free(recorded.data);
+    free(recorded.ref);
+    free(synthetic.data);
+    free(synthetic.ref);
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// Compara extract_features_q (ponto fixo) e extract_features com uma
+// implementação de referência em double que segue as fórmulas de
+// extract_movement_features do notebook de treino, em todas as janelas de
+// data/*.csv.
+//
+//   features_golden [arquivo.csv ...]
+//
+// Também confere as janelas parciais da classificação antecipada (2 a
+// WINDOW_SIZE - 1 amostras a partir de cada amostra): a referência aplica em
+// double a correção do desvio padrão e do ZCR para WINDOW_SIZE, e o caminho
+// float e o Q8 precisam concordar entre si.
+//
+// Tolerância: |q / 2^8 - ref|, |f - ref| e |f - q / 2^8| <= GOLDEN_TOLERANCE
+// para todas as features. Retorna 1 se alguma janela passar da tolerância.
+
+#include <math.h>
+#include <stdio.h>
+#include "include/features.h"
+#include "recording.h"
+
+#define GOLDEN_TOLERANCE (2.0 / (1 << FEATURE_Q_FRAC_BITS))
+
+static const char *feature_names[NUM_FEATURES] = {
+    "std_ax", "std_ay", "std_az", "std_gx", "std_gy", "std_gz",
+    "mag_accel", "mag_gyro", "range_ax", "range_ay", "range_az",
+    "zcr_ax", "zcr_ay", "zcr_az"
+};
+
+// np.sign: -1, 0 ou 1
+static double sign(double x) {
+    return (x > 0) - (x < 0);
+}
+
+static void reference_features(int16_t (*w)[6], int n, double *f) {
+    for (int c = 0; c < 6; c++) {
+        double mean = 0, sq = 0;
+        for (int i = 0; i < n; i++) mean += w[i][c];
+        mean /= n;
+        for (int i = 0; i < n; i++) sq += (w[i][c] - mean) * (w[i][c] - mean);
+        f[c] = sqrt(sq / n);
+    }
+
+    double mag_a = 0, mag_g = 0;
+    for (int i = 0; i < n; i++) {
+        mag_a += sqrt((double)w[i][0] * w[i][0] + (double)w[i][1] * w[i][1] + (double)w[i][2] * w[i][2]);
+        mag_g += sqrt((double)w[i][3] * w[i][3] + (double)w[i][4] * w[i][4] + (double)w[i][5] * w[i][5]);
+    }
+    f[6] = mag_a / n;
+    f[7] = mag_g / n;
+
+    for (int c = 0; c < 3; c++) {
+        int lo = w[0][c], hi = w[0][c];
+        double mean = 0;
+        for (int i = 0; i < n; i++) {
+            if (w[i][c] < lo) lo = w[i][c];
+            if (w[i][c] > hi) hi = w[i][c];
+            mean += w[i][c];
+        }
+        mean /= n;
+
+        // np.sum(np.abs(np.diff(np.sign(x - mean)))) / 2
+        double steps = 0;
+        for (int i = 1; i < n; i++) steps += fabs(sign(w[i][c] - mean) - sign(w[i - 1][c] - mean));
+        f[8 + c] = hi - lo;
+        f[11 + c] = steps / 2;
+    }
+}
+
+// Janela parcial de n amostras: desvio padrão com a variância amostral
+// levada a (WINDOW_SIZE - 1) / WINDOW_SIZE, como a da janela cheia, e ZCR
+// estendido de n - 1 para WINDOW_SIZE - 1 pares
+static void reference_partial(int16_t (*w)[6], int n, double *f) {
+    reference_features(w, n, f);
+    double var_scale = (double)n * (WINDOW_SIZE - 1) / ((double)(n - 1) * WINDOW_SIZE);
+    for (int c = 0; c < 6; c++) f[c] *= sqrt(var_scale);
+    for (int c = 0; c < 3; c++) f[11 + c] *= (double)(WINDOW_SIZE - 1) / (n - 1);
+}
+
+typedef struct {
+    double q[NUM_FEATURES], f[NUM_FEATURES], fq[NUM_FEATURES];   // erro máximo
+    long windows;
+} GoldenErrors;
+
+static void compare(WindowBuffer *win, const double *ref, GoldenErrors *e) {
+    int32_t q[NUM_FEATURES];
+    float f[NUM_FEATURES];
+    extract_features_q(win, q);
+    extract_features(win, f);
+
+    for (int j = 0; j < NUM_FEATURES; j++) {
+        double qf = q[j] / (double)(1 << FEATURE_Q_FRAC_BITS);
+        double eq = fabs(qf - ref[j]), ef = fabs(f[j] - ref[j]), efq = fabs(f[j] - qf);
+        if (eq > e->q[j]) e->q[j] = eq;
+        if (ef > e->f[j]) e->f[j] = ef;
+        if (efq > e->fq[j]) e->fq[j] = efq;
+    }
+    e->windows++;
+}
+
+static int report(const char *title, const GoldenErrors *e) {
+    int failed = 0;
+    printf("%s: %ld janelas\n", title, e->windows);
+    printf("%-10s %14s %14s %14s\n", "feature", "erro max (q)", "erro max (f)", "max |f - q|");
+    for (int j = 0; j < NUM_FEATURES; j++) {
+        bool bad = e->q[j] > GOLDEN_TOLERANCE || e->f[j] > GOLDEN_TOLERANCE || e->fq[j] > GOLDEN_TOLERANCE;
+        printf("%-10s %14.6f %14.6f %14.6f%s\n", feature_names[j], e->q[j], e->f[j], e->fq[j],
+               bad ? "  FALHOU" : "");
+        failed |= bad;
+    }
+    return failed;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {
+        DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+        DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv"
+    };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int num_files = argc > 1 ? argc - 1 : 4;
+
+    static GoldenErrors full, partial;
+
+    for (int k = 0; k < num_files; k++) {
+        Recording rec;
+        if (!recording_load(files[k], &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", files[k]);
+            return 2;
+        }
+
+        static WindowBuffer win;
+        double ref[NUM_FEATURES];
+        window_init(&win);
+
+        for (size_t i = 0; i < rec.count; i++) {
+            window_add_sample(&win, &rec.rows[i][0], &rec.rows[i][3]);
+            if (!window_is_ready(&win)) continue;
+            reference_features(&rec.rows[i + 1 - WINDOW_SIZE], WINDOW_SIZE, ref);
+            compare(&win, ref, &full);
+        }
+
+        // Janelas parciais começando em cada amostra
+        for (size_t i = 0; i + WINDOW_SIZE <= rec.count; i++) {
+            window_init(&win);
+            window_add_sample(&win, &rec.rows[i][0], &rec.rows[i][3]);
+            for (int n = 2; n < WINDOW_SIZE; n++) {
+                window_add_sample(&win, &rec.rows[i + n - 1][0], &rec.rows[i + n - 1][3]);
+                reference_partial(&rec.rows[i], n, ref);
+                compare(&win, ref, &partial);
+            }
+        }
+        recording_free(&rec);
+    }
+
+    printf("WINDOW_SIZE: %d | FEATURES_FIXED_POINT: %d | tolerancia: %.5f\n\n", WINDOW_SIZE,
+           FEATURES_FIXED_POINT, GOLDEN_TOLERANCE);
+    int failed = report("janela cheia", &full);
+    printf("\n");
+    failed |= report("janela parcial (2 a WINDOW_SIZE - 1 amostras)", &partial);
+    printf(failed ? "FALHOU\n" : "OK\n");
+    return failed;
+}
@@ -0,0 +1,182 @@
+// Gera a matriz de features de treino com o extrator do próprio firmware
+// (src/features.c), em várias threads, no formato NPY do numpy.
+//
+//   featurize [-j threads] [-s stride] [-S] [-o prefixo] [arquivo.csv|.imuc ...]
+//
+// Escreve <prefixo>_X.npy (float32, janelas x NUM_FEATURES) e
+// <prefixo>_y.npy (int32, índice da classe na ordem do LabelEncoder), que o
+// notebook carrega com np.load. A classe vem do prefixo do nome do arquivo.
+// Cada arquivo é janelado separadamente; WINDOW_SIZE é o do build
+// (-DEVAL_WINDOW_SIZE) e o salto padrão é WINDOW_HOP (STRIDE do treino).
+//
+// Com -S, cada linha ganha as SPECTRAL_NUM_FEATURES features espectrais de
+// src/spectral.cpp (janelas x (NUM_FEATURES + SPECTRAL_NUM_FEATURES)). A
+// primeira janela de cada arquivo passa a fechar só depois de
+// SPECTRAL_FFT_SIZE amostras, quando as duas janelas estão cheias.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/features.h"
+#include "include/spectral.h"
+#include "imu_columns.h"
+
+#define FEATURIZE_CHUNK_WINDOWS 256
+
+// Ordem do LabelEncoder do treino (alfabética), igual a ai_class_t
+static const char *class_names[NUM_CLASSES] = { "caminhando", "correndo", "parado", "pulando" };
+
+typedef struct {
+    const imucol::ColumnFile *rec;
+    size_t first_end;   // índice da última amostra da primeira janela
+    int windows;
+    size_t out_row;     // primeira linha da saída
+} FeaturizeTask;
+
+static int label_of(const char *name) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        if (strncmp(name, class_names[c], strlen(class_names[c])) == 0) return c;
+    }
+    return -1;
+}
+
+// Cabeçalho NPY 1.0: magic, versão, tamanho do dicionário (múltiplo de 64)
+static bool write_npy(const std::string &path, const char *descr, const std::string &shape,
+                      const void *data, size_t bytes) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (fp == NULL) return false;
+
+    std::string header = std::string("{'descr': '") + descr +
+                         "', 'fortran_order': False, 'shape': " + shape + ", }";
+    size_t total = 10 + header.size() + 1;
+    header.append((64 - total % 64) % 64, ' ');
+    header.push_back('\n');
+
+    uint16_t hlen = (uint16_t)header.size();
+    fwrite("\x93NUMPY\x01\x00", 1, 8, fp);
+    fputc(hlen & 0xff, fp);
+    fputc(hlen >> 8, fp);
+    fwrite(header.data(), 1, header.size(), fp);
+    fwrite(data, 1, bytes, fp);
+    return fclose(fp) == 0;
+}
+
+int main(int argc, char **argv) {
+    int threads = (int)std::thread::hardware_concurrency();
+    int stride = WINDOW_HOP;
+    bool spectral = false;
+    std::string prefix = "features";
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) stride = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) prefix = argv[++i];
+        else if (strcmp(argv[i], "-S") == 0) spectral = true;
+        else files.push_back(argv[i]);
+    }
+    if (threads < 1) threads = 1;
+    if (stride < 1) stride = 1;
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    // Amostras até a primeira janela; colunas por linha
+    const int warm = spectral && SPECTRAL_FFT_SIZE > WINDOW_SIZE ? SPECTRAL_FFT_SIZE : WINDOW_SIZE;
+    const int cols = NUM_FEATURES + (spectral ? SPECTRAL_NUM_FEATURES : 0);
+
+    /* ---------- Gravações e tarefas ---------- */
+    std::vector<imucol::ColumnFile> recs(files.size());
+    std::vector<FeaturizeTask> tasks;
+    std::vector<int32_t> labels;
+
+    for (size_t k = 0; k < files.size(); k++) {
+        if (!recs[k].open(files[k])) {
+            fprintf(stderr, "%s\n", recs[k].error().c_str());
+            return 2;
+        }
+        int label = label_of(recs[k].label().c_str());
+        if (label < 0) {
+            fprintf(stderr, "%s: classe desconhecida (o nome deve comecar por uma classe)\n", files[k]);
+            return 2;
+        }
+        if (recs[k].size() < (size_t)warm) continue;
+
+        long n = (long)(recs[k].size() - warm) / stride + 1;
+        for (long w = 0; w < n; w += FEATURIZE_CHUNK_WINDOWS) {
+            FeaturizeTask t;
+            t.rec = &recs[k];
+            t.first_end = warm - 1 + (size_t)w * stride;
+            t.windows = (int)(n - w < FEATURIZE_CHUNK_WINDOWS ? n - w : FEATURIZE_CHUNK_WINDOWS);
+            t.out_row = labels.size() + (size_t)w;
+            tasks.push_back(t);
+        }
+        labels.insert(labels.end(), (size_t)n, label);
+    }
+
+    /* ---------- Extração ---------- */
+    std::vector<float> features(labels.size() * cols);
+    std::atomic<size_t> next{0};
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int w = 0; w < threads; w++) {
+        pool.emplace_back([&] {
+            WindowBuffer *win = new WindowBuffer;
+            SpectralWindow *sw = new SpectralWindow;
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < tasks.size();) {
+                const FeaturizeTask &t = tasks[i];
+                float *out = &features[t.out_row * cols];
+
+                // Aquece as janelas com as warm - 1 amostras anteriores; depois
+                // uma linha a cada stride amostras, como o WindowScheduler
+                window_init(win);
+                spectral_init(sw);
+                size_t start = t.first_end + 1 - warm;
+                imucol::WindowView span = t.rec->window(start, t.first_end + (size_t)(t.windows - 1) * stride + 1 - start);
+                for (size_t s = 0; s < span.length; s++) {
+                    int16_t accel[3], gyro[3];
+                    span.sample(s, accel, gyro);
+                    window_add_sample(win, accel, gyro);
+                    if (spectral) spectral_add_sample(sw, win);
+                    if (s + 1 < (size_t)warm || (s + 1 - warm) % stride != 0) continue;
+
+                    extract_features(win, out);
+                    if (spectral) spectral_extract(sw, out + NUM_FEATURES);
+                    out += cols;
+                }
+            }
+            delete sw;
+            delete win;
+        });
+    }
+    for (std::thread &t : pool) t.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    /* ---------- Saída ---------- */
+    size_t n = labels.size();
+    std::string x_path = prefix + "_X.npy", y_path = prefix + "_y.npy";
+    if (!write_npy(x_path, "<f4", "(" + std::to_string(n) + ", " + std::to_string(cols) + ")",
+                   features.data(), features.size() * sizeof(float)) ||
+        !write_npy(y_path, "<i4", "(" + std::to_string(n) + ",)", labels.data(), n * sizeof(int32_t))) {
+        fprintf(stderr, "erro ao escrever %s / %s\n", x_path.c_str(), y_path.c_str());
+        return 2;
+    }
+
+    long per_class[NUM_CLASSES] = {0};
+    for (int32_t l : labels) per_class[l]++;
+    printf("%s, %s: %zu janelas x %d | WINDOW_SIZE: %d | stride: %d | FEATURES_FIXED_POINT: %d\n",
+           x_path.c_str(), y_path.c_str(), n, cols, WINDOW_SIZE, stride, FEATURES_FIXED_POINT);
+    if (spectral) printf("espectrais: FFT de %d pontos, %d bandas\n", SPECTRAL_FFT_SIZE, SPECTRAL_BANDS);
+    for (int c = 0; c < NUM_CLASSES; c++) printf("  %d %-12s %ld\n", c, class_names[c], per_class[c]);
+    printf("%.3f s | %.0f janelas/s | %d threads\n", secs, n / secs, threads);
+
+    return 0;
+}
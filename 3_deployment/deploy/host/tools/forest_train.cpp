@@ -0,0 +1,325 @@
+// Treina uma floresta aleatória pequena sobre a entrada int8 do modelo, a
+// mesma que o firmware entrega ao backend (extract_features_int8 com
+// ai_input_quant), e exporta em JSON para host/tools/gen_forest.py.
+//
+//   forest_train [-t arvores] [-d profundidade] [-m min_folha] [-f features_por_no]
+//                [-r semente] [-v fracao_validacao] [-o forest.json] [arquivo.csv ...]
+//
+// Janelas com salto de 1 amostra. A validação é o trecho final de cada
+// gravação (fração -v), separado do treino por WINDOW_SIZE amostras para as
+// janelas não se sobreporem. Cada árvore é um CART (Gini) sobre uma amostra
+// bootstrap, sorteando -f features por nó (padrão: raiz do total).
+//
+// O JSON segue os arrays de sklearn.tree.Tree (children_left,
+// children_right, feature, threshold, value), então uma floresta treinada
+// no notebook sobre a mesma entrada int8 pode ser exportada no mesmo
+// formato. Imprime a acurácia de validação da floresta e do MLP lado a lado.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "include/ai_backend.h"
+#include "include/ai_core.h"
+#include "include/window_scheduler.h"
+#include "recording.h"
+
+// Ordem do LabelEncoder do treino (alfabética), igual a ai_class_t
+static const char *class_names[NUM_CLASSES] = { "caminhando", "correndo", "parado", "pulando" };
+
+struct Sample {
+    int8_t x[NUM_FEATURES];
+    int8_t label;
+};
+
+// Nó na ordem de criação (pré-ordem), como o sklearn
+struct Node {
+    int left = -1, right = -1;
+    int feature = -2;
+    double threshold = -2.0;
+    int counts[NUM_CLASSES] = {};
+};
+
+struct TrainConfig {
+    int trees = 8;
+    int depth = 4;
+    int min_leaf = 5;
+    int max_features = 0;
+    uint64_t seed = 1;
+};
+
+static uint64_t rng_state;
+
+// splitmix64: reprodutível entre plataformas, ao contrário de rand()
+static uint64_t rng_next() {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int rng_below(int n) {
+    return (int)(rng_next() % (uint64_t)n);
+}
+
+static int label_of(const char *name) {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        if (strncmp(name, class_names[c], strlen(class_names[c])) == 0) return c;
+    }
+    return -1;
+}
+
+static double gini(const int *counts, int n) {
+    if (n == 0) return 0.0;
+    double s = 0;
+    for (int c = 0; c < NUM_CLASSES; c++) s += (double)counts[c] * counts[c];
+    return 1.0 - s / ((double)n * n);
+}
+
+static int build(std::vector<Node> &tree, const std::vector<Sample> &data, std::vector<int> &idx,
+                 int depth, const TrainConfig &cfg) {
+    int id = (int)tree.size();
+    tree.emplace_back();
+    for (int i : idx) tree[id].counts[data[i].label]++;
+
+    const int n = (int)idx.size();
+    int classes_present = 0;
+    for (int c = 0; c < NUM_CLASSES; c++) classes_present += tree[id].counts[c] > 0;
+    if (depth == cfg.depth || n < 2 * cfg.min_leaf || classes_present < 2) return id;
+
+    int order[NUM_FEATURES];
+    for (int f = 0; f < NUM_FEATURES; f++) order[f] = f;
+    for (int f = 0; f < cfg.max_features; f++) std::swap(order[f], order[f + rng_below(NUM_FEATURES - f)]);
+
+    const double parent = gini(tree[id].counts, n);
+    double best_gain = 1e-9;
+    int best_f = -1, best_t = 0;
+    for (int k = 0; k < cfg.max_features; k++) {
+        const int f = order[k];
+        static int hist[256][NUM_CLASSES];
+        memset(hist, 0, sizeof(hist));
+        for (int i : idx) hist[data[i].x[f] + 128][data[i].label]++;
+
+        // Limiar t: x <= t à esquerda
+        int left[NUM_CLASSES] = {}, right[NUM_CLASSES];
+        memcpy(right, tree[id].counts, sizeof(right));
+        int nl = 0;
+        for (int v = 0; v < 255; v++) {
+            int moved = 0;
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                left[c] += hist[v][c];
+                right[c] -= hist[v][c];
+                moved += hist[v][c];
+            }
+            if (moved == 0) continue;
+            nl += moved;
+            const int nr = n - nl;
+            if (nl < cfg.min_leaf) continue;
+            if (nr < cfg.min_leaf) break;
+            double gain = parent - (nl * gini(left, nl) + nr * gini(right, nr)) / n;
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_f = f;
+                best_t = v - 128;
+            }
+        }
+    }
+    if (best_f < 0) return id;
+
+    std::vector<int> li, ri;
+    for (int i : idx) (data[i].x[best_f] <= best_t ? li : ri).push_back(i);
+    idx.clear();
+    idx.shrink_to_fit();
+
+    tree[id].feature = best_f;
+    tree[id].threshold = best_t + 0.5;   // entre valores inteiros, como o sklearn
+    int l = build(tree, data, li, depth + 1, cfg);
+    int r = build(tree, data, ri, depth + 1, cfg);
+    tree[id].left = l;
+    tree[id].right = r;
+    return id;
+}
+
+static void predict(const std::vector<std::vector<Node>> &forest, const int8_t *x, double *proba) {
+    for (int c = 0; c < NUM_CLASSES; c++) proba[c] = 0;
+    for (const std::vector<Node> &tree : forest) {
+        int i = 0;
+        while (tree[i].left >= 0) i = x[tree[i].feature] <= tree[i].threshold ? tree[i].left : tree[i].right;
+        int total = 0;
+        for (int c = 0; c < NUM_CLASSES; c++) total += tree[i].counts[c];
+        for (int c = 0; c < NUM_CLASSES; c++) proba[c] += (double)tree[i].counts[c] / total;
+    }
+}
+
+static int argmax(const double *v) {
+    int best = 0;
+    for (int c = 1; c < NUM_CLASSES; c++) {
+        if (v[c] > v[best]) best = c;
+    }
+    return best;
+}
+
+static bool write_json(const char *path, const std::vector<std::vector<Node>> &forest, const TrainConfig &cfg,
+                       float input_scale, int32_t input_zero_point) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) return false;
+
+    fprintf(fp, "{\n  \"n_features\": %d,\n  \"classes\": [", NUM_FEATURES);
+    for (int c = 0; c < NUM_CLASSES; c++) fprintf(fp, "%s\"%s\"", c ? ", " : "", class_names[c]);
+    fprintf(fp, "],\n  \"input_scale\": %.9g,\n  \"input_zero_point\": %d,\n", input_scale, input_zero_point);
+    fprintf(fp, "  \"max_depth\": %d,\n  \"min_samples_leaf\": %d,\n  \"max_features\": %d,\n  \"seed\": %llu,\n",
+            cfg.depth, cfg.min_leaf, cfg.max_features, (unsigned long long)cfg.seed);
+    fprintf(fp, "  \"trees\": [\n");
+
+    for (size_t k = 0; k < forest.size(); k++) {
+        const std::vector<Node> &tree = forest[k];
+        fprintf(fp, "    {\n");
+        const char *keys[] = { "children_left", "children_right", "feature" };
+        for (int key = 0; key < 3; key++) {
+            fprintf(fp, "      \"%s\": [", keys[key]);
+            for (size_t i = 0; i < tree.size(); i++) {
+                int v = key == 0 ? tree[i].left : key == 1 ? tree[i].right : tree[i].feature;
+                fprintf(fp, "%s%d", i ? ", " : "", v);
+            }
+            fprintf(fp, "],\n");
+        }
+        fprintf(fp, "      \"threshold\": [");
+        for (size_t i = 0; i < tree.size(); i++) fprintf(fp, "%s%.1f", i ? ", " : "", tree[i].threshold);
+        fprintf(fp, "],\n      \"value\": [");
+        for (size_t i = 0; i < tree.size(); i++) {
+            fprintf(fp, "%s[", i ? ", " : "");
+            for (int c = 0; c < NUM_CLASSES; c++) fprintf(fp, "%s%d", c ? ", " : "", tree[i].counts[c]);
+            fprintf(fp, "]");
+        }
+        fprintf(fp, "]\n    }%s\n", k + 1 < forest.size() ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    return fclose(fp) == 0;
+}
+
+int main(int argc, char **argv) {
+    TrainConfig cfg;
+    double holdout = 0.25;
+    const char *out_path = DEPLOY_DIR "/forest.json";
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) cfg.trees = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) cfg.depth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) cfg.min_leaf = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) cfg.max_features = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) cfg.seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) holdout = atof(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+    if (cfg.trees < 1 || cfg.depth < 1 || cfg.depth > 12 || cfg.min_leaf < 1) {
+        fprintf(stderr, "parametros invalidos\n");
+        return 2;
+    }
+    if (cfg.max_features <= 0) cfg.max_features = (int)std::lround(std::sqrt((double)NUM_FEATURES));
+    if (cfg.max_features > NUM_FEATURES) cfg.max_features = NUM_FEATURES;
+    rng_state = cfg.seed;
+
+    // A entrada int8 depende da quantização do modelo atual (ai_input_quant)
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+
+    std::vector<Sample> train, valid;
+    long mlp_hits = 0;
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            return 2;
+        }
+        int label = label_of(rec.label);
+        if (label < 0) {
+            fprintf(stderr, "%s: classe desconhecida\n", rec.label);
+            return 2;
+        }
+
+        size_t split = (size_t)((double)rec.count * (1.0 - holdout));
+        static WindowScheduler sched;
+        scheduler_init(&sched, 1);
+        for (size_t i = 0; i < rec.count; i++) {
+            if (!scheduler_add_sample(&sched, &rec.rows[i][0], &rec.rows[i][3])) continue;
+
+            Sample s;
+            s.label = (int8_t)label;
+            extract_features_int8(&sched.win, ai_input_quant(), s.x);
+            if (i < split) {
+                train.push_back(s);
+            } else if (i >= split + WINDOW_SIZE) {
+                valid.push_back(s);
+                memcpy(ai_input_buffer(), s.x, NUM_FEATURES);
+                mlp_hits += ai_classify().cls == label;
+            }
+        }
+        recording_free(&rec);
+    }
+    if (train.empty()) {
+        fprintf(stderr, "sem janelas de treino\n");
+        return 2;
+    }
+
+    std::vector<std::vector<Node>> forest(cfg.trees);
+    for (std::vector<Node> &tree : forest) {
+        std::vector<int> idx(train.size());
+        for (int &i : idx) i = rng_below((int)train.size());
+        build(tree, train, idx, 0, cfg);
+    }
+
+    long train_hits = 0, valid_hits = 0;
+    double proba[NUM_CLASSES];
+    for (const Sample &s : train) {
+        predict(forest, s.x, proba);
+        train_hits += argmax(proba) == s.label;
+    }
+    long confusion[NUM_CLASSES][NUM_CLASSES] = {};
+    for (const Sample &s : valid) {
+        predict(forest, s.x, proba);
+        int p = argmax(proba);
+        valid_hits += p == s.label;
+        confusion[s.label][p]++;
+    }
+
+    size_t nodes = 0;
+    for (const std::vector<Node> &tree : forest) nodes += tree.size();
+    printf("%d arvores, profundidade %d, min_folha %d, %d features por no: %zu nos\n", cfg.trees, cfg.depth,
+           cfg.min_leaf, cfg.max_features, nodes);
+    printf("janelas: %zu treino, %zu validacao\n", train.size(), valid.size());
+    printf("acuracia treino: floresta %.2f%%\n", 100.0 * train_hits / train.size());
+    if (!valid.empty()) {
+        printf("acuracia validacao: floresta %.2f%% | mlp %.2f%%\n", 100.0 * valid_hits / valid.size(),
+               100.0 * mlp_hits / valid.size());
+        printf("\n%-12s", "real\\pred");
+        for (int c = 0; c < NUM_CLASSES; c++) printf(" %10s", class_names[c]);
+        printf("\n");
+        for (int r = 0; r < NUM_CLASSES; r++) {
+            printf("%-12s", class_names[r]);
+            for (int c = 0; c < NUM_CLASSES; c++) printf(" %10ld", confusion[r][c]);
+            printf("\n");
+        }
+    }
+
+    // Escala e zero_point da entrada int8 usada no treino: a floresta gerada
+    // declara os mesmos, então ai_input_quant não muda ao trocar de backend
+    ai_backend_quant_t quant;
+    ai_backend_init(ai_backend_default(), &quant);
+    if (!write_json(out_path, forest, cfg, quant.input_scale, quant.input_zero_point)) {
+        fprintf(stderr, "nao foi possivel escrever %s\n", out_path);
+        return 2;
+    }
+    printf("\n%s\n", out_path);
+    return 0;
+}
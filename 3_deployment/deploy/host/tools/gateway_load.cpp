@@ -0,0 +1,234 @@
+// Gerador de carga do motor de gateway (host/stream_engine.h): reproduz
+// data/*.csv como N wearables simultâneos e mede latência e vazão à medida
+// que N cresce.
+//
+//   gateway_load [-n 1,10,100,...] [-j workers] [-p produtores] [-d segundos]
+//                [-x aceleracao] [-q max_fila] [-G] [arquivo.csv ...]
+//
+// O stream k repete a gravação k % arquivos a partir de um deslocamento
+// próprio e começa com a janela cheia em fase diferente dos outros, para as
+// janelas não fecharem todas no mesmo instante. Os produtores (-p) dividem
+// os streams entre si e entregam uma amostra de cada stream a cada
+// SAMPLE_INTERVAL_MS / aceleracao; com -x 0 entregam o mais rápido possível
+// (vazão máxima, limitada pela fila -q). -G desliga o gate de movimento.
+//
+// Para cada N: janelas classificadas, janelas/s (e o alvo quando há ritmo),
+// fração decidida pelo gate, latência p50/p90/p99/máx da janela fechar até
+// o resultado e o maior atraso dos produtores em relação ao ritmo. Retorna
+// 1 se alguma janela se perder ou o modelo falhar.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "stream_engine.h"
+#include "recording.h"
+
+// Deslocamento entre os pontos de partida dos streams na gravação
+#define LOAD_STREAM_OFFSET 7919
+
+typedef struct {
+    const Recording *rec;
+    size_t cursor;
+    gateway::Stream *stream;
+} LoadStream;
+
+// Resultados de um worker; alinhado para os workers não disputarem linhas
+struct alignas(64) WorkerLog {
+    std::vector<uint32_t> latency_ns;
+    long gated = 0;
+    long errors = 0;
+};
+
+struct LoadReport {
+    long windows;
+    long expected;
+    long gated;
+    long errors;
+    double secs;
+    double max_lag_ms;
+    std::vector<uint32_t> latency_ns;
+};
+
+static double percentile_us(const std::vector<uint32_t> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+static bool run_load(const std::vector<Recording> &recs, int n_streams, const gateway::EngineConfig &cfg,
+                     int producers, double seconds, double speedup, LoadReport *rep) {
+    std::vector<WorkerLog> logs;
+    gateway::Engine engine(cfg, [&](int w, const gateway::Result &r) {
+        WorkerLog &log = logs[w];
+        log.latency_ns.push_back(r.latency_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)r.latency_ns);
+        log.gated += r.gated;
+        log.errors += r.result.cls == AI_ERRO;
+    });
+    logs.resize(engine.workers());
+    if (!engine.start()) {
+        fprintf(stderr, "%s\n", engine.error().c_str());
+        return false;
+    }
+
+    // Streams aquecidos com WINDOW_SIZE - 1 - (k % hop) amostras: as
+    // primeiras janelas fecham escalonadas ao longo de um hop
+    std::vector<LoadStream> streams(n_streams);
+    for (int k = 0; k < n_streams; k++) {
+        LoadStream &ls = streams[k];
+        ls.rec = &recs[k % recs.size()];
+        ls.cursor = ((size_t)k * LOAD_STREAM_OFFSET) % ls.rec->count;
+        ls.stream = engine.add_stream();
+        int warm = WINDOW_SIZE - 1 - k % cfg.hop;
+        for (int i = 0; i < warm; i++) {
+            int16_t *s = ls.rec->rows[ls.cursor];
+            engine.push(ls.stream, &s[0], &s[3]);
+            ls.cursor = (ls.cursor + 1) % ls.rec->count;
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double, std::milli>(speedup > 0 ? SAMPLE_INTERVAL_MS / speedup : 0.0));
+    const auto t0 = clock::now();
+    const auto deadline = t0 + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(seconds));
+    std::vector<double> lag_ms(producers, 0.0);
+
+    std::vector<std::thread> pool;
+    for (int p = 0; p < producers; p++) {
+        pool.emplace_back([&, p] {
+            for (long tick = 0;; tick++) {
+                auto now = clock::now();
+                if (now >= deadline) break;
+                if (speedup > 0) {
+                    auto target = t0 + period * tick;
+                    if (now < target) {
+                        std::this_thread::sleep_until(target);
+                    } else {
+                        double lag = std::chrono::duration<double, std::milli>(now - target).count();
+                        if (lag > lag_ms[p]) lag_ms[p] = lag;
+                    }
+                }
+                for (int k = p; k < n_streams; k += producers) {
+                    LoadStream &ls = streams[k];
+                    int16_t *s = ls.rec->rows[ls.cursor];
+                    engine.push(ls.stream, &s[0], &s[3]);
+                    if (++ls.cursor == ls.rec->count) ls.cursor = 0;
+                }
+            }
+        });
+    }
+    for (std::thread &t : pool) t.join();
+    engine.drain();
+    rep->secs = std::chrono::duration<double>(clock::now() - t0).count();
+    engine.stop();
+
+    rep->windows = rep->gated = rep->errors = rep->expected = 0;
+    rep->latency_ns.clear();
+    for (const WorkerLog &log : logs) {
+        rep->latency_ns.insert(rep->latency_ns.end(), log.latency_ns.begin(), log.latency_ns.end());
+        rep->gated += log.gated;
+        rep->errors += log.errors;
+    }
+    rep->windows = (long)rep->latency_ns.size();
+    for (const LoadStream &ls : streams) rep->expected += ls.stream->windows();
+    std::sort(rep->latency_ns.begin(), rep->latency_ns.end());
+    rep->max_lag_ms = *std::max_element(lag_ms.begin(), lag_ms.end());
+    return true;
+}
+
+static std::vector<int> parse_list(const char *s) {
+    std::vector<int> out;
+    while (*s != '\0') {
+        char *end;
+        long v = strtol(s, &end, 10);
+        if (end == s) break;
+        if (v > 0) out.push_back((int)v);
+        s = *end == ',' ? end + 1 : end;
+    }
+    return out;
+}
+
+int main(int argc, char **argv) {
+    std::vector<int> counts = { 1, 10, 100, 1000, 10000 };
+    gateway::EngineConfig cfg;
+    int producers = 1;
+    double seconds = 2.0, speedup = 10.0;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) counts = parse_list(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) cfg.workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) producers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) speedup = atof(argv[++i]);
+        else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) cfg.max_pending = (size_t)atol(argv[++i]);
+        else if (strcmp(argv[i], "-G") == 0) cfg.motion_gate = false;
+        else files.push_back(argv[i]);
+    }
+    if (producers < 1) producers = 1;
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+
+    std::vector<Recording> recs;
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            return 2;
+        }
+        if (rec.count == 0) {
+            recording_free(&rec);
+            continue;
+        }
+        recs.push_back(rec);
+    }
+    if (recs.empty()) return 2;
+
+    int workers = cfg.workers > 0 ? cfg.workers : (int)std::thread::hardware_concurrency();
+    char pace[32] = "sem ritmo";
+    if (speedup > 0) snprintf(pace, sizeof(pace), "ritmo %gx", speedup);
+    printf("%zu gravacoes | workers: %d | produtores: %d | hop: %d | gate: %s | %s | %zu bytes/stream\n\n",
+           recs.size(), workers, producers, cfg.hop, cfg.motion_gate ? "sim" : "nao", pace,
+           sizeof(gateway::Stream));
+
+    printf("%8s %10s %12s %12s %6s %9s %9s %9s %9s %10s\n", "streams", "janelas", "janelas/s", "alvo/s",
+           "gate", "p50 us", "p90 us", "p99 us", "max us", "atraso ms");
+
+    bool ok = true;
+    for (int n : counts) {
+        LoadReport rep;
+        if (!run_load(recs, n, cfg, producers, seconds, speedup, &rep)) return 2;
+
+        char target[16] = "-";
+        if (speedup > 0) {
+            snprintf(target, sizeof(target), "%.0f", n * speedup * (1000.0 / SAMPLE_INTERVAL_MS) / cfg.hop);
+        }
+        printf("%8d %10ld %12.0f %12s %5.1f%% %9.1f %9.1f %9.1f %9.1f %10.1f\n", n, rep.windows,
+               rep.windows / rep.secs, target, rep.windows ? 100.0 * rep.gated / rep.windows : 0.0,
+               percentile_us(rep.latency_ns, 0.50), percentile_us(rep.latency_ns, 0.90),
+               percentile_us(rep.latency_ns, 0.99), percentile_us(rep.latency_ns, 1.0), rep.max_lag_ms);
+        fflush(stdout);
+
+        if (rep.windows != rep.expected || rep.errors > 0) {
+            fprintf(stderr, "N=%d: %ld janelas enfileiradas, %ld entregues, %ld erros do modelo\n", n,
+                    rep.expected, rep.windows, rep.errors);
+            ok = false;
+        }
+    }
+
+    for (Recording &rec : recs) recording_free(&rec);
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
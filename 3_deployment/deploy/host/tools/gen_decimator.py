@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Gera decimator_coeffs.h (FIR de compensação do CIC) para src/decimator.c.
+
+    python3 host/tools/gen_decimator.py [--input-rate 1000] [--cic-ratio 25]
+        [--order 3] [--fir-ratio 2] [--taps 31] [--passband 6] [saida.h]
+
+O decimador é um CIC de ordem N (razão R) seguido de um FIR de fase linear
+que decima por 2. O FIR é projetado por janela (Kaiser) sobre a resposta
+desejada: 1/|H_cic(f)| até a banda passante, transição em cosseno levantado
+até fs_saida - banda passante (primeira frequência que rebate sobre a banda
+passante) e zero acima. Os coeficientes saem em Q15 com soma exata 32768
+(ganho DC 1). Os parâmetros têm que bater com os de config.h.
+
+Só usa a biblioteca padrão do Python.
+"""
+
+import argparse
+import math
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEPLOY_DIR = os.path.normpath(os.path.join(HERE, "..", ".."))
+
+KAISER_BETA = 5.0
+GRID_POINTS = 4000
+
+
+def cic_gain(f, fs, ratio, order):
+    """|H_cic(f)| normalizado (ganho DC 1), f e fs na taxa de entrada."""
+    x = math.pi * f / fs
+    if x == 0:
+        return 1.0
+    return abs(math.sin(ratio * x) / (ratio * math.sin(x))) ** order
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def desired(f, args):
+    fs_out = args.input_rate / (args.cic_ratio * args.fir_ratio)
+    fp, fstop = args.passband, fs_out - args.passband
+    comp = lambda v: 1.0 / cic_gain(v, args.input_rate, args.cic_ratio, args.order)
+    if f <= fp:
+        return comp(f)
+    if f >= fstop:
+        return 0.0
+    t = (f - fp) / (fstop - fp)
+    return comp(fp) * 0.5 * (1 + math.cos(math.pi * t))
+
+
+def design(args):
+    fs_mid = args.input_rate / args.cic_ratio
+    m = (args.taps - 1) // 2
+    step = (fs_mid / 2) / GRID_POINTS
+    grid = [(i * step, desired(i * step, args)) for i in range(GRID_POINTS + 1)]
+
+    taps = []
+    for n in range(-m, m + 1):
+        acc = 0.0
+        for i, (f, d) in enumerate(grid):
+            w = 0.5 if i in (0, GRID_POINTS) else 1.0
+            acc += w * d * math.cos(2 * math.pi * f * n / fs_mid)
+        h = 2 * acc * step / fs_mid
+        window = bessel_i0(KAISER_BETA * math.sqrt(1 - (n / m) ** 2)) / bessel_i0(KAISER_BETA)
+        taps.append(h * window)
+
+    dc = sum(taps)
+    taps = [t / dc for t in taps]
+    q = [int(round(t * 32768)) for t in taps]
+    q[m] += 32768 - sum(q)   # ganho DC exato
+    if sum(abs(v) for v in q) >= 65536:
+        sys.exit("coeficientes somam |c| >= 2: o acumulador de 32 bits pode estourar")
+    return q
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--input-rate", type=int, default=1000, help="Hz")
+    ap.add_argument("--cic-ratio", type=int, default=25)
+    ap.add_argument("--order", type=int, default=3)
+    ap.add_argument("--fir-ratio", type=int, default=2)
+    ap.add_argument("--taps", type=int, default=31)
+    ap.add_argument("--passband", type=float, default=6.0, help="Hz")
+    ap.add_argument("output", nargs="?", default=os.path.join(DEPLOY_DIR, "decimator_coeffs.h"))
+    args = ap.parse_args()
+
+    if args.taps % 2 == 0:
+        sys.exit("--taps precisa ser ímpar (fase linear tipo I)")
+    coeffs = design(args)
+    fs_out = args.input_rate / (args.cic_ratio * args.fir_ratio)
+
+    # 1 / R^N como multiplicador de 31 bits e shift
+    gain = args.cic_ratio ** args.order
+    shift = 31 + int(math.floor(math.log2(gain)))
+    mult = int(round(2 ** shift / gain))
+    if mult >= 2 ** 31:
+        shift -= 1
+        mult = int(round(2 ** shift / gain))
+    if 16 + math.log2(gain) > 31:
+        sys.exit("R^N grande demais: a saída do CIC não cabe em 32 bits")
+
+    lines = [
+        "// Gerado por host/tools/gen_decimator.py - nao editar.",
+        "// CIC %d x ordem %d + FIR de compensacao %d taps / %d: %d Hz -> %g Hz,"
+        % (args.cic_ratio, args.order, args.taps, args.fir_ratio, args.input_rate, fs_out),
+        "// banda passante %g Hz." % args.passband,
+        "",
+        "#ifndef DECIMATOR_COEFFS_H",
+        "#define DECIMATOR_COEFFS_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define DECIM_GEN_INPUT_RATE_HZ %d" % args.input_rate,
+        "#define DECIM_GEN_CIC_RATIO %d" % args.cic_ratio,
+        "#define DECIM_GEN_CIC_ORDER %d" % args.order,
+        "#define DECIM_GEN_FIR_RATIO %d" % args.fir_ratio,
+        "#define DECIM_FIR_TAPS %d" % args.taps,
+        "#define DECIM_PASSBAND_HZ %g" % args.passband,
+        "",
+        "// Ganho do CIC (R^N = %d) compensado por (x * MULT) >> SHIFT" % gain,
+        "#define DECIM_CIC_NORM_MULT %d" % mult,
+        "#define DECIM_CIC_NORM_SHIFT %d" % shift,
+        "",
+        "// Q15, simétricos, soma 32768",
+        "static const int16_t decim_fir_coeffs[DECIM_FIR_TAPS] = {",
+    ]
+    for i in range(0, len(coeffs), 8):
+        lines.append("    " + ", ".join("%d" % c for c in coeffs[i:i + 8]) + ",")
+    lines += ["};", "", "#endif", ""]
+
+    with open(args.output, "w") as fp:
+        fp.write("\n".join(lines))
+    print("%s: %d taps, %d Hz -> %g Hz" % (args.output, args.taps, args.input_rate, fs_out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Gera model_forest.h (floresta de árvores para include/forest_kernel.h).
+
+    python3 host/tools/gen_forest.py [forest.json] [model_forest.h]
+
+O JSON tem os arrays de sklearn.tree.Tree de cada árvore (children_left,
+children_right, feature, threshold, value) mais a quantização da entrada
+int8 sobre a qual a floresta foi treinada. host/build/forest_train escreve
+esse formato; no notebook, uma RandomForestClassifier treinada sobre a
+mesma entrada int8 é exportada com:
+
+    {"classes": list(le.classes_), "input_scale": s, "input_zero_point": zp,
+     "trees": [{k: getattr(e.tree_, k).tolist() for k in
+                ("children_left", "children_right", "feature", "threshold")}
+               | {"value": e.tree_.value[:, 0, :].tolist()}
+               for e in rf.estimators_]}
+
+Como a entrada é inteira, "x <= 3.5" vira "x <= 3"; testes que o int8
+nunca satisfaz (ou sempre satisfaz) somem. Cada árvore é completada até a
+maior profundidade da floresta para a descida ficar sem desvio.
+"""
+
+import json
+import math
+import os
+import sys
+
+DEPLOY_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+CLASSES = ["caminhando", "correndo", "parado", "pulando"]
+
+# Nó completado: x <= 127 é sempre verdade, então desce à esquerda
+PAD_FEATURE, PAD_THRESHOLD = 0, 127
+
+
+def simplify(tree, node):
+    """Segue testes degenerados no int8 até um nó com dois lados possíveis."""
+    left, right = tree["children_left"], tree["children_right"]
+    while left[node] >= 0:
+        t = math.floor(tree["threshold"][node])
+        if t >= 127:
+            node = left[node]
+        elif t < -128:
+            node = right[node]
+        else:
+            break
+    return node
+
+
+def depth_of(tree, node=0):
+    node = simplify(tree, node)
+    if tree["children_left"][node] < 0:
+        return 0
+    return 1 + max(depth_of(tree, tree["children_left"][node]),
+                   depth_of(tree, tree["children_right"][node]))
+
+
+def leaf_q(value):
+    total = float(sum(value))
+    return [int(round(255 * v / total)) if total > 0 else 0 for v in value]
+
+
+def flatten(tree, depth, n_classes):
+    nodes = (1 << depth) - 1
+    feature = [PAD_FEATURE] * nodes
+    threshold = [PAD_THRESHOLD] * nodes
+    leaves = [[0] * n_classes for _ in range(1 << depth)]
+
+    def fill(pos, node, level):
+        node = simplify(tree, node)
+        if tree["children_left"][node] >= 0:
+            feature[pos] = tree["feature"][node]
+            threshold[pos] = math.floor(tree["threshold"][node])
+            fill(2 * pos + 1, tree["children_left"][node], level + 1)
+            fill(2 * pos + 2, tree["children_right"][node], level + 1)
+            return
+        # Folha antes da última camada: o caminho completado sempre vai à
+        # esquerda; as outras folhas da subárvore recebem o mesmo valor
+        q = leaf_q(tree["value"][node])
+        first, count = pos, 1
+        while level < depth:
+            first, count, level = 2 * first + 1, count * 2, level + 1
+        for k in range(first, first + count):
+            leaves[k - nodes] = q
+
+    fill(0, 0, 0)
+    return feature, threshold, leaves
+
+
+def emit(model, depth, flat, json_path):
+    n_classes = len(model["classes"])
+    out = []
+    out.append("// Gerado por host/tools/gen_forest.py a partir de %s - nao editar." % os.path.basename(json_path))
+    out.append("// Floresta de %d arvores completadas ate a profundidade %d para include/forest_kernel.h."
+               % (len(flat), depth))
+    out.append("")
+    out.append("#ifndef MODEL_FOREST_H")
+    out.append("#define MODEL_FOREST_H")
+    out.append("")
+    out.append('#include "include/forest_kernel.h"')
+    out.append("")
+    out.append("namespace model_forest {")
+    out.append("")
+    out.append("constexpr float kInputScale = %r;" % float(model["input_scale"]))
+    out.append("constexpr int32_t kInputZeroPoint = %d;" % model["input_zero_point"])
+    out.append("constexpr float kOutputScale = 1.0f / 255;")
+    out.append("constexpr int32_t kOutputZeroPoint = -128;")
+    out.append("constexpr int kInputSize = %d;" % model.get("n_features", 14))
+    out.append("constexpr int kOutputSize = %d;" % n_classes)
+    out.append("constexpr int kTrees = %d;" % len(flat))
+    out.append("constexpr int kDepth = %d;" % depth)
+    out.append("")
+    out.append("constexpr forest::Forest<kTrees, kDepth, kOutputSize> kForest = {{")
+    for k, (feature, threshold, leaves) in enumerate(flat):
+        out.append("    // Arvore %d" % k)
+        out.append("    {")
+        out.append("        {%s}," % ", ".join(str(v) for v in feature))
+        out.append("        {%s}," % ", ".join(str(v) for v in threshold))
+        out.append("        {")
+        for i in range(0, len(leaves), 8):
+            out.append("            %s," % ", ".join("{%s}" % ", ".join(str(v) for v in leaf)
+                                                     for leaf in leaves[i:i + 8]))
+        out.append("        },")
+        out.append("    },")
+    out.append("}};")
+    out.append("")
+    out.append("inline void invoke(const int8_t *input, int8_t *output) {")
+    out.append("    forest::invoke(kForest, input, output);")
+    out.append("}")
+    out.append("")
+    out.append("} // namespace model_forest")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    json_path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(DEPLOY_DIR, "forest.json")
+    out_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(DEPLOY_DIR, "model_forest.h")
+
+    with open(json_path) as f:
+        model = json.load(f)
+    if model["classes"] != CLASSES:
+        raise SystemExit("classes %s diferentes de ai_class_t %s" % (model["classes"], CLASSES))
+
+    trees = model["trees"]
+    depth = max(max(depth_of(t) for t in trees), 1)
+    flat = [flatten(t, depth, len(CLASSES)) for t in trees]
+
+    with open(out_path, "w") as f:
+        f.write(emit(model, depth, flat, json_path))
+
+    nodes = sum(len(t["children_left"]) for t in trees)
+    print("%s: %d arvores, %d nos -> profundidade %d (%d nos por arvore)"
+          % (out_path, len(trees), nodes, depth, (1 << depth) - 1))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,356 @@
+#!/usr/bin/env python3
+"""Gera model_mlp.h (kernel MLP int8 sem interpretador) a partir do model.h.
+
+    python3 host/tools/gen_mlp.py [model.h] [model_mlp.h]
+
+Lê o flatbuffer embutido em model.h, extrai pesos, bias e parâmetros de
+quantização de cada FULLY_CONNECTED e do SOFTMAX final, e escreve arrays
+constexpr para include/mlp_kernel.h. Os multiplicadores são calculados
+como no Prepare do TFLM (QuantizeMultiplier / PreprocessSoftmaxScaling),
+para que a saída seja bit a bit igual à do interpretador.
+
+Só usa a biblioteca padrão do Python.
+"""
+
+import math
+import os
+import re
+import struct
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEPLOY_DIR = os.path.normpath(os.path.join(HERE, "..", ".."))
+
+# Códigos do schema do TFLite
+OP_FULLY_CONNECTED = 9
+OP_SOFTMAX = 25
+TENSOR_INT32 = 2
+TENSOR_INT8 = 9
+ACT_NONE, ACT_RELU, ACT_RELU_N1_TO_1, ACT_RELU6 = 0, 1, 2, 3
+
+# Bits inteiros da diferença escalada no softmax int8 do TFLM
+SOFTMAX_DIFF_INTEGER_BITS = 5
+
+
+# ---------- Leitura do flatbuffer ----------
+
+class FlatBuffer:
+    def __init__(self, buf):
+        self.buf = buf
+
+    def u16(self, o):
+        return struct.unpack_from("<H", self.buf, o)[0]
+
+    def u32(self, o):
+        return struct.unpack_from("<I", self.buf, o)[0]
+
+    def i32(self, o):
+        return struct.unpack_from("<i", self.buf, o)[0]
+
+    def f32(self, o):
+        return struct.unpack_from("<f", self.buf, o)[0]
+
+    def deref(self, o):
+        return o + self.u32(o)
+
+    def table(self, o):
+        """Retorna field(i) -> offset absoluto do campo i (ou None)."""
+        vt = o - self.i32(o)
+        vlen = self.u16(vt)
+
+        def field(i):
+            if 4 + 2 * i >= vlen:
+                return None
+            off = self.u16(vt + 4 + 2 * i)
+            return o + off if off else None
+
+        return field
+
+    def vector(self, o):
+        o = self.deref(o)
+        return o + 4, self.u32(o)
+
+    def tables(self, o):
+        start, n = self.vector(o)
+        return [self.table(self.deref(start + 4 * k)) for k in range(n)]
+
+    def values(self, o, fmt):
+        start, n = self.vector(o)
+        size = struct.calcsize(fmt)
+        return [struct.unpack_from(fmt, self.buf, start + size * k)[0] for k in range(n)]
+
+    def string(self, o):
+        start, n = self.vector(o)
+        return self.buf[start:start + n].decode()
+
+
+def read_model_h(path):
+    """Extrai os bytes de model_data[] do header gerado pelo notebook."""
+    text = open(path).read()
+    body = text[text.index("model_data[]"):]
+    body = body[body.index("{") + 1:body.index("}")]
+    return bytes(int(tok, 16) for tok in re.findall(r"0x[0-9a-fA-F]{2}", body))
+
+
+class Tensor:
+    def __init__(self, fb, t, buffers):
+        self.name = fb.string(t(3)) if t(3) else ""
+        self.shape = fb.values(t(0), "<i") if t(0) else []
+        self.type = fb.buf[t(1)] if t(1) else 0
+        self.scale, self.zero_point = [], []
+        if t(4):
+            q = fb.table(fb.deref(t(4)))
+            if q(2):
+                self.scale = fb.values(q(2), "<f")
+            if q(3):
+                self.zero_point = fb.values(q(3), "<q")
+
+        self.data = b""
+        b = buffers[fb.u32(t(2))] if t(2) else None
+        if b is not None and b(0):
+            start, n = fb.vector(b(0))
+            self.data = fb.buf[start:start + n]
+
+    def int8(self):
+        return list(struct.unpack("<%db" % len(self.data), self.data))
+
+    def int32(self):
+        return list(struct.unpack("<%di" % (len(self.data) // 4), self.data))
+
+
+def parse_model(buf):
+    fb = FlatBuffer(buf)
+    root = fb.table(fb.deref(0))
+
+    opcodes = []
+    for oc in fb.tables(root(1)):
+        code = fb.buf[oc(0)] if oc(0) else 0
+        if oc(3):
+            code = max(code, fb.i32(oc(3)))
+        opcodes.append(code)
+
+    subgraphs = fb.tables(root(2))
+    if len(subgraphs) != 1:
+        raise SystemExit("esperado 1 subgrafo, encontrado %d" % len(subgraphs))
+    sg = subgraphs[0]
+
+    buffers = fb.tables(root(4))
+    tensors = [Tensor(fb, t, buffers) for t in fb.tables(sg(0))]
+
+    ops = []
+    for op in fb.tables(sg(3)):
+        code = opcodes[fb.u32(op(0)) if op(0) else 0]
+        inputs = fb.values(op(1), "<i")
+        outputs = fb.values(op(2), "<i")
+        options = fb.table(fb.deref(op(4))) if op(4) else (lambda i: None)
+        if code == OP_FULLY_CONNECTED:
+            act = fb.buf[options(0)] if options(0) else ACT_NONE
+            ops.append(("fc", inputs, outputs, act))
+        elif code == OP_SOFTMAX:
+            beta = fb.f32(options(0)) if options(0) else 1.0
+            ops.append(("softmax", inputs, outputs, beta))
+        else:
+            raise SystemExit("operador nao suportado pelo kernel MLP: %d" % code)
+
+    sg_inputs = fb.values(sg(1), "<i")
+    sg_outputs = fb.values(sg(2), "<i")
+    return tensors, ops, sg_inputs, sg_outputs
+
+
+# ---------- Quantização (mesma aritmética do TFLM) ----------
+
+def quantize_multiplier(real):
+    """tflite::QuantizeMultiplier: real = mult * 2^(shift - 31)."""
+    if real == 0.0:
+        return 0, 0
+    q, shift = math.frexp(real)
+    q_fixed = int(math.floor(q * (1 << 31) + 0.5))  # TfLiteRound (q > 0)
+    if q_fixed == (1 << 31):
+        q_fixed //= 2
+        shift += 1
+    if shift < -31:
+        return 0, 0
+    return q_fixed, shift
+
+
+def f32(x):
+    return struct.unpack("<f", struct.pack("<f", x))[0]
+
+
+def activation_range(act, scale, zero_point):
+    """tflite::CalculateActivationRangeQuantized para int8."""
+    qmin, qmax = -128, 127
+
+    def quantize(v):
+        r = v / scale   # TfLiteRound: metade se afasta do zero
+        return zero_point + int(math.copysign(math.floor(abs(r) + 0.5), r))
+
+    if act == ACT_RELU:
+        return max(qmin, quantize(0.0)), qmax
+    if act == ACT_RELU6:
+        return max(qmin, quantize(0.0)), min(qmax, quantize(6.0))
+    if act == ACT_RELU_N1_TO_1:
+        return max(qmin, quantize(-1.0)), min(qmax, quantize(1.0))
+    return qmin, qmax
+
+
+def dense_layer(tensors, inputs, outputs, act):
+    x, w, b = (tensors[i] if i >= 0 else None for i in inputs)
+    y = tensors[outputs[0]]
+    if x.type != TENSOR_INT8 or w.type != TENSOR_INT8 or y.type != TENSOR_INT8:
+        raise SystemExit("FULLY_CONNECTED precisa ser int8")
+    if any(z != 0 for z in w.zero_point):
+        raise SystemExit("pesos com zero_point != 0")
+
+    n_out, n_in = w.shape
+    weights = w.int8()
+    bias = b.int32() if b is not None else [0] * n_out
+
+    # sum(w * (x + off)) + b = sum(w * x) + (b + off * sum(w)): o offset da
+    # entrada vai para o bias e o laço interno fica só com x * w
+    input_offset = -x.zero_point[0]
+    bias = [bias[c] + input_offset * sum(weights[c * n_in:(c + 1) * n_in]) for c in range(n_out)]
+
+    mult, shift = [], []
+    for c in range(n_out):
+        if len(w.scale) == 1:
+            # Por tensor: o TFLM multiplica as escalas em float
+            real = f32(x.scale[0] * w.scale[0]) / y.scale[0]
+        else:
+            real = x.scale[0] * w.scale[c] / y.scale[0]
+        m, s = quantize_multiplier(real)
+        mult.append(m)
+        shift.append(s)
+
+    act_min, act_max = activation_range(act, y.scale[0], y.zero_point[0])
+    return {
+        "in": n_in, "out": n_out, "weights": weights, "bias": bias,
+        "mult": mult, "shift": shift,
+        "output_offset": y.zero_point[0],
+        "act_min": act_min, "act_max": act_max,
+        "name": y.name.split(";")[0],
+    }
+
+
+def softmax_layer(tensors, inputs, outputs, beta):
+    x = tensors[inputs[0]]
+    y = tensors[outputs[0]]
+    if y.zero_point[0] != -128 or y.scale[0] != 1.0 / 256:
+        raise SystemExit("softmax int8 precisa de saida com escala 1/256 e zero_point -128")
+
+    # tflite::PreprocessSoftmaxScaling + CalculateInputRadius
+    bits = SOFTMAX_DIFF_INTEGER_BITS
+    real = min(beta * x.scale[0] * (1 << (31 - bits)), (1 << 31) - 1.0)
+    mult, left_shift = quantize_multiplier(real)
+    if left_shift < 0:
+        raise SystemExit("multiplicador do softmax menor que 1")
+    radius = ((1 << bits) - 1) * (1 << (31 - bits)) / (1 << left_shift)
+    return {"n": x.shape[-1], "mult": mult, "left_shift": left_shift,
+            "diff_min": -int(math.floor(radius))}
+
+
+# ---------- Escrita do header ----------
+
+def c_array(values, per_line=16, indent="    "):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def emit(layers, softmax, x, y, model_path):
+    out = []
+    out.append("// Gerado por host/tools/gen_mlp.py a partir de %s - nao editar." % os.path.basename(model_path))
+    out.append("// Pesos, bias e multiplicadores do MLP int8 para include/mlp_kernel.h.")
+    out.append("")
+    out.append("#ifndef MODEL_MLP_H")
+    out.append("#define MODEL_MLP_H")
+    out.append("")
+    out.append('#include "include/mlp_kernel.h"')
+    out.append("")
+    out.append("namespace model_mlp {")
+    out.append("")
+    out.append("constexpr float kInputScale = %r;" % x.scale[0])
+    out.append("constexpr int32_t kInputZeroPoint = %d;" % x.zero_point[0])
+    out.append("constexpr float kOutputScale = %r;" % y.scale[0])
+    out.append("constexpr int32_t kOutputZeroPoint = %d;" % y.zero_point[0])
+    out.append("constexpr int kInputSize = %d;" % layers[0]["in"])
+    out.append("constexpr int kOutputSize = %d;" % softmax["n"])
+    out.append("")
+
+    for i, l in enumerate(layers):
+        n_in, n_out = l["in"], l["out"]
+        out.append("// Camada %d: %s (%d -> %d)" % (i, l["name"], n_in, n_out))
+        out.append("constexpr mlp::Dense<%d, %d> kDense%d = {" % (n_in, n_out, i))
+        out.append("    {")
+        for r in range(n_out):
+            out.append("        {%s}," % ", ".join(str(v) for v in l["weights"][r * n_in:(r + 1) * n_in]))
+        out.append("    },")
+        out.append("    {")
+        out.append(c_array(l["bias"], 8, "        "))
+        out.append("    },")
+        out.append("    {")
+        out.append(c_array(l["mult"], 8, "        "))
+        out.append("    },")
+        out.append("    {")
+        out.append(c_array(l["shift"], 16, "        "))
+        out.append("    },")
+        out.append("    %d, %d, %d," % (l["output_offset"], l["act_min"], l["act_max"]))
+        out.append("};")
+        out.append("")
+
+    out.append("constexpr mlp::Softmax<%d> kSoftmax = { %d, %d, %d };" %
+               (softmax["n"], softmax["mult"], softmax["left_shift"], softmax["diff_min"]))
+    out.append("")
+
+    # Ativações intermediárias: buffers do chamador, sem arena
+    out.append("// Ativações intermediárias")
+    out.append("struct Scratch {")
+    for i, l in enumerate(layers):
+        out.append("    int8_t a%d[%d];" % (i, l["out"]))
+    out.append("};")
+    out.append("")
+    out.append("inline void invoke(const int8_t *input, int8_t *output, Scratch &s) {")
+    src = "input"
+    for i in range(len(layers)):
+        out.append("    mlp::dense(kDense%d, %s, s.a%d);" % (i, src, i))
+        src = "s.a%d" % i
+    out.append("    mlp::softmax(kSoftmax, %s, output);" % src)
+    out.append("}")
+    out.append("")
+    out.append("} // namespace model_mlp")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    model_path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(DEPLOY_DIR, "model.h")
+    out_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(DEPLOY_DIR, "model_mlp.h")
+
+    tensors, ops, sg_inputs, sg_outputs = parse_model(read_model_h(model_path))
+
+    layers, softmax = [], None
+    prev = sg_inputs[0]
+    for kind, inputs, outputs, opt in ops:
+        if inputs[0] != prev or softmax is not None:
+            raise SystemExit("o kernel MLP so suporta uma cadeia FC... -> SOFTMAX")
+        if kind == "fc":
+            layers.append(dense_layer(tensors, inputs, outputs, opt))
+        else:
+            softmax = softmax_layer(tensors, inputs, outputs, opt)
+        prev = outputs[0]
+    if softmax is None or prev != sg_outputs[0]:
+        raise SystemExit("o modelo precisa terminar em SOFTMAX")
+
+    text = emit(layers, softmax, tensors[sg_inputs[0]], tensors[sg_outputs[0]], model_path)
+    with open(out_path, "w") as f:
+        f.write(text)
+
+    shape = " -> ".join([str(layers[0]["in"])] + [str(l["out"]) for l in layers])
+    print("%s: %s + softmax" % (out_path, shape))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,89 @@
+// Converte gravações entre CSV (data/*.csv) e o formato colunar .imuc.
+//
+//   imu_convert [-r taxa_hz] [-l rotulo] entrada.csv saida.imuc
+//   imu_convert entrada.imuc saida.csv
+//   imu_convert -i arquivo.imuc [...]      (mostra o cabeçalho)
+//
+// Sem -l, o rótulo é o nome do arquivo; sem -r, a taxa é a nominal do
+// collect_data (50 Hz).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "imu_columns.h"
+
+static int show_info(const char *path) {
+    imucol::ColumnFile f;
+    auto t0 = std::chrono::steady_clock::now();
+    if (!f.open(path)) {
+        fprintf(stderr, "%s\n", f.error().c_str());
+        return 2;
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    const imucol::ImuColumnsHeader &h = f.header();
+    printf("%s: v%u.%u | rotulo '%s' | %zu amostras | %.1f Hz | accel %.0f LSB/g | gyro %.1f LSB/(dps) | aberto em %.0f us\n",
+           path, h.version_major, h.version_minor, f.label().c_str(), f.size(), f.sample_rate_hz(),
+           h.accel_lsb_per_g, h.gyro_lsb_per_dps, us);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    float rate = 0.0f;
+    std::string label;
+    bool info = false;
+    std::vector<const char *> paths;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) rate = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) label = argv[++i];
+        else if (strcmp(argv[i], "-i") == 0) info = true;
+        else paths.push_back(argv[i]);
+    }
+
+    if (info) {
+        int ret = 0;
+        for (const char *p : paths) ret |= show_info(p);
+        return ret;
+    }
+    if (paths.size() != 2) {
+        fprintf(stderr, "uso: imu_convert [-r taxa_hz] [-l rotulo] entrada.csv saida.imuc\n"
+                        "     imu_convert entrada.imuc saida.csv\n"
+                        "     imu_convert -i arquivo.imuc\n");
+        return 2;
+    }
+
+    imucol::ColumnFile in;
+    if (!in.open(paths[0])) {
+        fprintf(stderr, "%s\n", in.error().c_str());
+        return 2;
+    }
+    std::string out = paths[1];
+
+    if (out.size() > 4 && out.compare(out.size() - 4, 4, ".csv") == 0) {
+        FILE *fp = fopen(out.c_str(), "w");
+        if (fp == NULL) {
+            fprintf(stderr, "nao foi possivel criar %s\n", out.c_str());
+            return 2;
+        }
+        for (size_t i = 0; i < in.size(); i++) {
+            fprintf(fp, "%d,%d,%d,%d,%d,%d\n", in.column(0)[i], in.column(1)[i], in.column(2)[i],
+                    in.column(3)[i], in.column(4)[i], in.column(5)[i]);
+        }
+        fclose(fp);
+    } else {
+        const int16_t *cols[imucol::kAxes];
+        for (int a = 0; a < imucol::kAxes; a++) cols[a] = in.column(a);
+        float out_rate = rate > 0 ? rate : in.sample_rate_hz() > 0 ? in.sample_rate_hz() : 50.0f;
+        if (!imucol::write_file(out, label.empty() ? in.label() : label, out_rate, cols, in.size(),
+                                in.header().accel_lsb_per_g, in.header().gyro_lsb_per_dps)) {
+            fprintf(stderr, "erro ao escrever %s\n", out.c_str());
+            return 2;
+        }
+    }
+    printf("%s -> %s: %zu amostras\n", paths[0], out.c_str(), in.size());
+    return 0;
+}
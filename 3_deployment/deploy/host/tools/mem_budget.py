@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""Relatório de RAM/flash por módulo a partir do mapa do linker (GNU ld).
+
+    python3 host/tools/mem_budget.py deploy.elf.map [--ram-limit 64K] [--flash-limit 512K] [--top 10]
+
+Soma o tamanho de cada seção de entrada no arquivo objeto (ou biblioteca)
+de origem e classifica pela região de memória onde ela foi colocada:
+.data conta em RAM e também em flash (valores iniciais), pilhas e heap
+aparecem como módulos próprios. Com --ram-limit/--flash-limit o script
+retorna 1 quando o total passa do orçamento, o que falha o build.
+
+Só usa a biblioteca padrão do Python.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HEX = re.compile(r"^0x[0-9a-fA-F]+$")
+
+# Seções de saída com nome próprio no relatório (RP2040 / pico-sdk)
+NAMED_SECTIONS = {
+    ".stack_dummy": "(pilha core 0)",
+    ".stack1_dummy": "(pilha core 1)",
+    ".heap": "(heap)",
+}
+
+
+def parse_size(text):
+    """Aceita bytes, ou sufixos K/M (potências de 1024)."""
+    m = re.match(r"^(\d+)([kKmM]?)$", text)
+    if m is None:
+        raise argparse.ArgumentTypeError("tamanho invalido: %s" % text)
+    mult = {"": 1, "k": 1024, "m": 1024 * 1024}[m.group(2).lower()]
+    return int(m.group(1)) * mult
+
+
+def module_name(path):
+    """Agrupa um objeto pelo módulo a que pertence."""
+    if path.startswith("*fill*"):
+        return "(preenchimento)"
+
+    archive = re.match(r"^(.*?)\((.*)\)$", path)
+    if archive:
+        lib = os.path.basename(archive.group(1))
+        lib = re.sub(r"^lib|\.a$", "", lib)
+        return "tflm" if "tflmicro" in lib or "tensorflow" in lib else lib
+
+    # Fontes do pico-sdk são compiladas dentro do alvo: agrupa por biblioteca
+    sdk = re.search(r"/(?:rp2_common|common|rp2040|boards)/([^/]+)/", path)
+    if sdk and ("pico-sdk" in path or "/sdk/" in path):
+        return "sdk/" + sdk.group(1)
+    if "pico-tflmicro" in path or "/tensorflow/" in path:
+        return "tflm"
+    if "cyw43" in path or "lwip" in path:
+        return "wifi"
+
+    name = os.path.basename(path)
+    return re.sub(r"\.(obj|o)$", "", name)
+
+
+class MapFile:
+    def __init__(self, text):
+        self.regions = []       # (nome, origem, tamanho)
+        self.entries = []       # (modulo, secao_saida, secao_entrada, tamanho, vma, lma)
+        self._parse(text)
+
+    def _parse(self, text):
+        lines = text.splitlines()
+        i = 0
+
+        # Memory Configuration
+        while i < len(lines) and not lines[i].startswith("Memory Configuration"):
+            i += 1
+        i += 1
+        while i < len(lines) and not lines[i].startswith("Linker script and memory map"):
+            tok = lines[i].split()
+            if len(tok) >= 3 and HEX.match(tok[1]) and HEX.match(tok[2]) and tok[0] != "*default*":
+                self.regions.append((tok[0], int(tok[1], 16), int(tok[2], 16)))
+            i += 1
+
+        out_section, out_lma_delta = None, 0
+        while i < len(lines):
+            line = lines[i]
+            i += 1
+            if not line or line.startswith("LOAD ") or line.startswith("OUTPUT("):
+                continue
+
+            # Nomes longos quebram a linha: junta com a seguinte
+            tok = line.split()
+            if len(tok) == 1 and not line.startswith("  ") and i < len(lines):
+                nxt = lines[i].split()
+                if nxt and HEX.match(nxt[0]):
+                    tok += nxt
+                    i += 1
+
+            if not line.startswith(" "):
+                # Seção de saída: nome [vma tamanho] [load address lma]
+                if tok[0].startswith("."):
+                    out_section = tok[0]
+                    out_lma_delta = 0
+                    if len(tok) >= 3 and HEX.match(tok[1]):
+                        m = re.search(r"load address (0x[0-9a-fA-F]+)", line + " " + " ".join(tok))
+                        if m:
+                            out_lma_delta = int(m.group(1), 16) - int(tok[1], 16)
+                continue
+
+            if out_section is None or len(tok) < 3:
+                continue
+            name = tok[0]
+            if name.startswith("*") and name != "*fill*":
+                continue   # padrão do linker script, não é seção
+            if not (HEX.match(tok[1]) and HEX.match(tok[2])):
+                continue   # definição de símbolo
+
+            vma, size = int(tok[1], 16), int(tok[2], 16)
+            if size == 0:
+                continue
+            path = " ".join(tok[3:]) if len(tok) > 3 else "*fill*"
+            if name == "*fill*":
+                path = "*fill*"
+            module = NAMED_SECTIONS.get(out_section, module_name(path))
+            self.entries.append((module, out_section, name, size, vma, vma + out_lma_delta))
+
+    def region_of(self, addr):
+        for name, origin, length in self.regions:
+            if origin <= addr < origin + length:
+                return name
+        return None
+
+    def classify(self, out_section, vma, lma):
+        """Retorna (conta_flash, conta_ram) para uma seção de entrada."""
+        if self.regions:
+            vr, lr = self.region_of(vma), self.region_of(lma)
+            in_flash = lambda r: r is not None and "FLASH" in r.upper()
+            in_ram = lambda r: r is not None and ("RAM" in r.upper() or "SCRATCH" in r.upper())
+            return in_flash(vr) or in_flash(lr), in_ram(vr)
+
+        # Sem regiões (build do host): pelo nome da seção de saída
+        ram = out_section.startswith((".data", ".bss", ".tdata", ".tbss", ".got"))
+        flash = out_section.startswith((".text", ".rodata", ".init", ".fini", ".eh_frame",
+                                         ".gcc_except_table", ".data", ".tdata"))
+        return flash, ram
+
+    def budget(self):
+        modules = {}
+        top = []
+        self.region_used = {}
+        for module, out_section, name, size, vma, lma in self.entries:
+            flash, ram = self.classify(out_section, vma, lma)
+            if not flash and not ram:
+                continue
+            for r in {self.region_of(vma), self.region_of(lma)} - {None}:
+                self.region_used[r] = self.region_used.get(r, 0) + size
+            m = modules.setdefault(module, [0, 0])
+            if flash:
+                m[0] += size
+            if ram:
+                m[1] += size
+                top.append((size, name, module))
+        top.sort(reverse=True)
+        return modules, top
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("map")
+    ap.add_argument("--ram-limit", type=parse_size, default=0)
+    ap.add_argument("--flash-limit", type=parse_size, default=0)
+    ap.add_argument("--top", type=int, default=8, help="maiores seções em RAM")
+    args = ap.parse_args()
+
+    mf = MapFile(open(args.map, errors="replace").read())
+    modules, top = mf.budget()
+    total_flash = sum(m[0] for m in modules.values())
+    total_ram = sum(m[1] for m in modules.values())
+
+    print("%-28s %10s %10s" % ("modulo", "flash", "RAM"))
+    for name, (flash, ram) in sorted(modules.items(), key=lambda kv: -(kv[1][0] + kv[1][1])):
+        print("%-28s %10d %10d" % (name, flash, ram))
+    print("%-28s %10d %10d" % ("TOTAL", total_flash, total_ram))
+
+    for name, origin, length in mf.regions:
+        used = mf.region_used.get(name, 0)
+        print("regiao %-10s %8d de %8d bytes (%.1f%%)" % (name, used, length, 100.0 * used / length))
+
+    if args.top > 0 and top:
+        print("\nmaiores seções em RAM:")
+        for size, name, module in top[:args.top]:
+            print("  %8d  %-40s %s" % (size, name, module))
+
+    ok = True
+    for label, used, limit in (("RAM", total_ram, args.ram_limit), ("flash", total_flash, args.flash_limit)):
+        if limit and used > limit:
+            print("ERRO: %s %d bytes passa do orcamento de %d bytes (+%d)" % (label, used, limit, used - limit))
+            ok = False
+        elif limit:
+            print("%s: %d de %d bytes do orcamento (%.1f%%)" % (label, used, limit, 100.0 * used / limit))
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,212 @@
+// Confere o kernel MLP gerado (model_mlp.h + include/mlp_kernel.h) em todas
+// as janelas de data/*.csv (salto de 1 amostra).
+//
+//   mlp_exact_check [arquivo.csv ...]
+//
+// Com o TFLM disponível (DEPLOY_TFLM_DIR), a saída int8 de cada janela tem
+// que ser idêntica à do MicroInterpreter. Sem ele, cada camada é comparada
+// com uma referência em double alimentada pela saída da camada anterior do
+// kernel (tolerância de 1 LSB). Também imprime tempo por inferência e o
+// custo de flash/RAM de cada backend.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "include/ai_core.h"
+#include "include/window_scheduler.h"
+#include "model.h"
+#include "model_mlp.h"
+#include "recording.h"
+
+#if MLP_CHECK_TFLM
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace {
+    uint8_t tensor_arena[12 * 1024];
+}
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static const char *class_names[NUM_CLASSES] = { "caminhando", "correndo", "parado", "pulando" };
+
+/* ---------- Referência em double ---------- */
+
+template <int IN, int OUT>
+static int dense_error(const mlp::Dense<IN, OUT> &p, const int8_t *in, const int8_t *out) {
+    int worst = 0;
+    for (int o = 0; o < OUT; o++) {
+        int64_t acc = p.bias[o];
+        for (int i = 0; i < IN; i++) acc += (int64_t)p.weights[o][i] * in[i];
+        double real = std::ldexp((double)p.mult[o], p.shift[o] - 31);
+        double y = std::round(acc * real) + p.output_offset;
+        y = std::fmin(std::fmax(y, p.act_min), p.act_max);
+        int err = std::abs((int)y - out[o]);
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+template <int N>
+static int softmax_error(const mlp::Softmax<N> &p, const int8_t *in, const int8_t *out) {
+    // input_mult * 2^(left_shift - 31) = beta * escala * 2^(31 - 5)
+    double beta_scale = std::ldexp((double)p.input_mult, p.input_left_shift - 31 - 26);
+    double e[N], sum = 0;
+    int max_in = in[0];
+    for (int c = 1; c < N; c++) max_in = in[c] > max_in ? in[c] : max_in;
+    for (int c = 0; c < N; c++) {
+        e[c] = std::exp((in[c] - max_in) * beta_scale);
+        sum += e[c];
+    }
+
+    int worst = 0;
+    for (int c = 0; c < N; c++) {
+        double y = std::fmin(std::round(e[c] / sum * 256.0) - 128, 127);
+        int err = std::abs((int)y - out[c]);
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+static int argmax(const int8_t *v, int n) {
+    int best = 0;
+    for (int i = 1; i < n; i++) {
+        if (v[i] > v[best]) best = i;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {
+        DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+        DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv"
+    };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int num_files = argc > 1 ? argc - 1 : 4;
+
+    if (!ai_init()) {
+        fprintf(stderr, "ai_init falhou\n");
+        return 2;
+    }
+
+#if MLP_CHECK_TFLM
+    const tflite::Model *model = tflite::GetModel(model_data);
+    static tflite::MicroMutableOpResolver<4> resolver;
+    resolver.AddFullyConnected();
+    resolver.AddRelu();
+    resolver.AddSoftmax();
+    resolver.AddQuantize();
+    static tflite::MicroInterpreter interpreter(model, resolver, tensor_arena, sizeof(tensor_arena));
+    if (interpreter.AllocateTensors() != kTfLiteOk) {
+        fprintf(stderr, "AllocateTensors falhou\n");
+        return 2;
+    }
+    int8_t *tflm_in = interpreter.input(0)->data.int8;
+    const int8_t *tflm_out = interpreter.output(0)->data.int8;
+    long tflm_mismatches = 0;
+    uint64_t tflm_ns = 0;
+#endif
+
+    long windows = 0;
+    int worst_layer[4] = {0};
+    int worst_input = 0;
+    long input_diffs = 0;
+    uint64_t mlp_ns = 0;
+    model_mlp::Scratch scratch;
+
+    for (int k = 0; k < num_files; k++) {
+        Recording rec;
+        if (!recording_load(files[k], &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", files[k]);
+            return 2;
+        }
+
+        static WindowScheduler sched;
+        scheduler_init(&sched, 1);
+        long class_hits[NUM_CLASSES] = {0};
+
+        for (size_t i = 0; i < rec.count; i++) {
+            if (!scheduler_add_sample(&sched, &rec.rows[i][0], &rec.rows[i][3])) continue;
+
+            int8_t in[model_mlp::kInputSize], out[model_mlp::kOutputSize];
+            extract_features_int8(&sched.win, ai_input_quant(), in);
+
+            // ai_run_inference (features float) tem que quantizar como o caminho Q8
+            float f[NUM_FEATURES], conf;
+            extract_features(&sched.win, f);
+            ai_run_inference(f, &conf);
+            const int8_t *in_float = ai_input_buffer();
+            for (int j = 0; j < model_mlp::kInputSize; j++) {
+                int d = std::abs(in_float[j] - in[j]);
+                if (d > worst_input) worst_input = d;
+                input_diffs += d != 0;
+            }
+
+            Clock::time_point t0 = Clock::now();
+            model_mlp::invoke(in, out, scratch);
+            mlp_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+            int errs[4] = {
+                dense_error(model_mlp::kDense0, in, scratch.a0),
+                dense_error(model_mlp::kDense1, scratch.a0, scratch.a1),
+                dense_error(model_mlp::kDense2, scratch.a1, scratch.a2),
+                softmax_error(model_mlp::kSoftmax, scratch.a2, out),
+            };
+            for (int l = 0; l < 4; l++) {
+                if (errs[l] > worst_layer[l]) worst_layer[l] = errs[l];
+            }
+
+#if MLP_CHECK_TFLM
+            memcpy(tflm_in, in, sizeof(in));
+            t0 = Clock::now();
+            interpreter.Invoke();
+            tflm_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+            if (memcmp(tflm_out, out, sizeof(out)) != 0) {
+                if (tflm_mismatches++ < 5) {
+                    printf("%s janela %zu: mlp [%d %d %d %d] tflm [%d %d %d %d]\n", rec.label, i,
+                           out[0], out[1], out[2], out[3],
+                           tflm_out[0], tflm_out[1], tflm_out[2], tflm_out[3]);
+                }
+            }
+#endif
+            class_hits[argmax(out, NUM_CLASSES)]++;
+            windows++;
+        }
+
+        printf("%-12s", rec.label);
+        for (int c = 0; c < NUM_CLASSES; c++) printf(" %s=%ld", class_names[c], class_hits[c]);
+        printf("\n");
+        recording_free(&rec);
+    }
+
+    size_t mlp_flash = sizeof(model_mlp::kDense0) + sizeof(model_mlp::kDense1) +
+                       sizeof(model_mlp::kDense2) + sizeof(model_mlp::kSoftmax);
+    size_t mlp_ram = model_mlp::kInputSize + model_mlp::kOutputSize + sizeof(model_mlp::Scratch);
+
+    bool ok = worst_input <= 1 && worst_layer[0] <= 1 && worst_layer[1] <= 1 && worst_layer[2] <= 1 && worst_layer[3] <= 1;
+
+    printf("janelas: %ld\n", windows);
+    printf("entrada de ai_run_inference vs Q8: %ld valores diferentes, max %d LSB\n",
+           input_diffs, worst_input);
+    printf("erro max vs double (LSB): fc0 %d | fc1 %d | fc2 %d | softmax %d\n",
+           worst_layer[0], worst_layer[1], worst_layer[2], worst_layer[3]);
+    printf("%-6s %12s %14s %12s\n", "", "ns/inferencia", "flash (dados)", "RAM");
+    printf("%-6s %12.0f %14zu %12zu\n", "mlp", (double)mlp_ns / windows, mlp_flash, mlp_ram);
+#if MLP_CHECK_TFLM
+    printf("%-6s %12.0f %14zu %12zu (arena usada %zu)\n", "tflm", (double)tflm_ns / windows,
+           sizeof(model_data), sizeof(tensor_arena), interpreter.arena_used_bytes());
+    printf("divergencias bit a bit vs TFLM: %ld\n", tflm_mismatches);
+    ok = ok && tflm_mismatches == 0;
+#else
+    printf("%-6s %12s %14zu %12zu (sem TFLM: comparacao bit a bit nao executada)\n", "tflm", "-",
+           sizeof(model_data), (size_t)(12 * 1024));
+#endif
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// Exercita o driver do MPU6500 (src/mpu6500.c) contra o simulador de
+// registradores/FIFO (host/mpu6500_sim.c), alimentado por data/*.csv.
+//
+//   mpu6500_fifo_check [arquivo.csv ...]
+//
+// Cenários por arquivo:
+//   1. leitura direta dos registradores de dados, uma amostra por período;
+//   2. FIFO drenado em lotes de MPU6500_FIFO_BATCH: todas as amostras devem
+//      chegar íntegras, em ordem e sem overflow;
+//   3. igual ao 2, mas com um atraso longo no meio: o overflow deve ser
+//      detectado, o FIFO zerado, e as leituras seguintes voltar alinhadas.
+// Retorna 1 se algum cenário falhar.
+
+#include <stdio.h>
+#include <string.h>
+#include "include/mpu6500.h"
+#include "mpu6500_sim.h"
+#include "recording.h"
+#include "include/hal.h"
+#include "config.h"
+
+// O tempo do sensor é avançado explicitamente pelos cenários; as esperas
+// do driver (ex.: 100 ms no mpu6500_init) não consomem amostras.
+void hal_sleep_ms(uint32_t ms) {
+    (void)ms;
+}
+
+typedef struct {
+    const Recording *rec;
+    size_t next;
+} Feed;
+
+static bool feed_source(int16_t *accel, int16_t *gyro, void *ctx) {
+    Feed *feed = ctx;
+    if (feed->next >= feed->rec->count) return false;
+    memcpy(accel, &feed->rec->rows[feed->next][0], 3 * sizeof(int16_t));
+    memcpy(gyro, &feed->rec->rows[feed->next][3], 3 * sizeof(int16_t));
+    feed->next++;
+    return true;
+}
+
+static bool same_row(const int16_t *row, const int16_t *accel, const int16_t *gyro) {
+    return memcmp(row, accel, 3 * sizeof(int16_t)) == 0 && memcmp(row + 3, gyro, 3 * sizeof(int16_t)) == 0;
+}
+
+static void start(Feed *feed, const Recording *rec) {
+    feed->rec = rec;
+    feed->next = 0;
+    mpu6500_sim_init(feed_source, feed);
+    mpu6500_init();
+}
+
+static bool check_direct(const Recording *rec) {
+    Feed feed;
+    start(&feed, rec);
+
+    uint32_t period = mpu6500_sim_sample_period_us();
+    int16_t accel[3], gyro[3];
+    for (size_t i = 0; i < rec->count; i++) {
+        mpu6500_sim_advance_us(period);
+        mpu6500_read_data(accel, gyro);
+        if (!same_row(rec->rows[i], accel, gyro)) {
+            printf("  direto: amostra %zu diferente\n", i);
+            return false;
+        }
+    }
+
+    const Mpu6500SimStats *bus = mpu6500_sim_stats();
+    printf("  direto: %zu amostras | %.2f transacoes/amostra | %.1f bytes lidos/amostra\n",
+           rec->count, (bus->i2c_writes + bus->i2c_reads) / (double)rec->count,
+           bus->bytes_read / (double)rec->count);
+    return true;
+}
+
+// Drena o FIFO a cada MPU6500_FIFO_BATCH períodos, como o main.c. Se
+// `stall_at` >= 0, nessa rodada o consumidor atrasa o bastante para o FIFO
+// estourar; o driver deve detectar, zerar e voltar a entregar amostras
+// alinhadas. Confere a ordem e o conteúdo de tudo que chega.
+static bool check_fifo(const Recording *rec, int stall_at) {
+    static int16_t accel[MPU6500_FIFO_BATCH][3], gyro[MPU6500_FIFO_BATCH][3];
+    const int capacity = MPU6500_FIFO_SIZE / MPU6500_FIFO_FRAME;
+
+    Feed feed;
+    start(&feed, rec);
+    mpu6500_fifo_init(MPU6500_SAMPLE_RATE_DIV);
+    Mpu6500FifoStats before = *mpu6500_fifo_stats();
+    Mpu6500SimStats bus_before = *mpu6500_sim_stats();
+
+    uint32_t period = mpu6500_sim_sample_period_us();
+    size_t expected = 0, received = 0;
+    int overflows = 0;
+    bool resync = false;
+
+    for (int round = 0; feed.next < rec->count || mpu6500_fifo_count() >= MPU6500_FIFO_FRAME; round++) {
+        int periods = (round == stall_at) ? 2 * capacity : MPU6500_FIFO_BATCH;
+        mpu6500_sim_advance_us(periods * period);
+
+        int n;
+        do {
+            n = mpu6500_fifo_read(accel, gyro, MPU6500_FIFO_BATCH);
+            if (n == MPU6500_FIFO_OVERFLOW) {
+                overflows++;
+                resync = true;
+                break;
+            }
+            for (int i = 0; i < n; i++) {
+                if (resync) {
+                    // Depois do reset o fluxo recomeça em alguma amostra mais nova
+                    while (expected < rec->count && !same_row(rec->rows[expected], accel[i], gyro[i])) expected++;
+                    resync = false;
+                }
+                if (expected >= rec->count || !same_row(rec->rows[expected], accel[i], gyro[i])) {
+                    printf("  fifo: amostra %zu fora de ordem ou corrompida\n", received);
+                    return false;
+                }
+                expected++;
+                received++;
+            }
+        } while (mpu6500_fifo_stats()->pending > 0);
+    }
+
+    const Mpu6500FifoStats *st = mpu6500_fifo_stats();
+    const Mpu6500SimStats *bus = mpu6500_sim_stats();
+    uint32_t bursts = st->transactions - before.transactions;
+    uint32_t txns = (bus->i2c_writes + bus->i2c_reads) - (bus_before.i2c_writes + bus_before.i2c_reads);
+
+    printf("  fifo%s: %zu/%zu amostras | %lu rajadas | %.2f transacoes/amostra | "
+           "%.1f bytes lidos/amostra | overflows %d | perdidas no sensor %lu\n",
+           stall_at >= 0 ? " (com atraso)" : "", received, rec->count, (unsigned long)bursts,
+           txns / (double)(received ? received : 1),
+           (bus->bytes_read - bus_before.bytes_read) / (double)(received ? received : 1),
+           overflows, (unsigned long)bus->samples_lost);
+
+    if (stall_at >= 0) {
+        return overflows == 1 && received + capacity <= rec->count && expected == rec->count;
+    }
+    return overflows == 0 && received == rec->count;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {
+        DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+        DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv"
+    };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int num_files = argc > 1 ? argc - 1 : 4;
+    bool ok = true;
+
+    for (int k = 0; k < num_files; k++) {
+        Recording rec;
+        if (!recording_load(files[k], &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", files[k]);
+            return 2;
+        }
+
+        printf("%s (%zu amostras)\n", rec.label, rec.count);
+        ok &= check_direct(&rec);
+        ok &= check_fifo(&rec, -1);
+        ok &= check_fifo(&rec, 5);
+        recording_free(&rec);
+    }
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
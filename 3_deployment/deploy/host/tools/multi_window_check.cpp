@@ -0,0 +1,136 @@
+// Confere mwin::MultiWindow (include/multi_window.h) em data/*.csv: janelas
+// de 10, WINDOW_SIZE e 100 amostras sobre um anel só.
+//
+//   multi_window_check [arquivo.csv ...]
+//
+// A cada amostra, cada janela tem que ler exatamente as últimas N amostras
+// da gravação em ordem cronológica; a de WINDOW_SIZE tem que dar as mesmas
+// features (float e Q8, bit a bit) que WindowBuffer + extract_features, e
+// as outras as mesmas do lote escalar (features_batch), inclusive enquanto
+// a janela ainda não encheu. Também imprime a memória e o custo por amostra.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "include/multi_window.h"
+#include "features_batch.h"
+#include "recording.h"
+
+using Windows = mwin::MultiWindow<WINDOW_CHANNELS, 10, WINDOW_SIZE, 100>;
+static constexpr int kMainView = 1;
+
+// Referência para uma janela qualquer: as length linhas terminando em end
+static void reference_features(const Recording &rec, size_t end, int length, float *f) {
+    std::vector<int16_t> soa((size_t)WINDOW_CHANNELS * length);
+    for (int t = 0; t < length; t++) {
+        for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+            soa[(size_t)ch * length + t] = rec.rows[end + 1 - length + t][ch];
+        }
+    }
+    FeatureBatch b = { soa.data(), 1, 1, length };
+    features_batch_extract(&b, FEATURE_ISA_SCALAR, f);
+}
+
+static bool same(const void *a, const void *b, size_t bytes) {
+    return memcmp(a, b, bytes) == 0;
+}
+
+int main(int argc, char **argv) {
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) files.push_back(argv[i]);
+    if (files.empty()) {
+        files = { DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+                  DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv" };
+    }
+
+    bool ok = true;
+    size_t checked = 0, order_bad = 0, feat_bad[Windows::kViews] = {}, q_bad = 0;
+    double push_ns = 0, feat_ns = 0;
+    size_t timed = 0;
+
+    for (const char *path : files) {
+        Recording rec;
+        if (!recording_load(path, &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", path);
+            ok = false;
+            continue;
+        }
+
+        Windows w;
+        WindowBuffer win;
+        window_init(&win);
+
+        for (size_t i = 0; i < rec.count; i++) {
+            int16_t *row = rec.rows[i];
+            auto t0 = std::chrono::steady_clock::now();
+            w.push(&row[0], &row[3]);
+            auto t1 = std::chrono::steady_clock::now();
+            window_add_sample(&win, &row[0], &row[3]);
+
+            float f[Windows::kViews][NUM_FEATURES];
+            for (int v = 0; v < Windows::kViews; v++) mwin::features(w.view(v), f[v]);
+            auto t2 = std::chrono::steady_clock::now();
+            push_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            feat_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+            timed++;
+
+            for (int v = 0; v < Windows::kViews; v++) {
+                mwin::View view = w.view(v);
+                int expected_len = (int)(i + 1 < (size_t)Windows::kLengths[v] ? i + 1 : Windows::kLengths[v]);
+                if (view.size() != expected_len) order_bad++;
+
+                // Ordem cronológica, pelo acesso indexado e pelos trechos contíguos
+                for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+                    mwin::ChannelSpan s = view.channel(ch);
+                    int t = 0;
+                    s.for_each([&](int16_t x) {
+                        size_t src = i + 1 - view.size() + t;
+                        if (x != rec.rows[src][ch] || s[t] != x) order_bad++;
+                        t++;
+                    });
+                }
+
+                float ref[NUM_FEATURES];
+                reference_features(rec, i, view.size(), ref);
+                if (!same(f[v], ref, sizeof(ref))) feat_bad[v]++;
+            }
+
+            // Com a janela enchendo, WindowBuffer corrige desvio e ZCR para
+            // WINDOW_SIZE amostras (classificação antecipada); a vista não
+            checked++;
+            if (!window_is_ready(&win)) continue;
+            float f_win[NUM_FEATURES];
+            int32_t q_win[NUM_FEATURES], q_view[NUM_FEATURES];
+            extract_features(&win, f_win);
+            extract_features_q(&win, q_win);
+            mwin::features_q(w.template view<kMainView>(), q_view);
+            if (!same(f[kMainView], f_win, sizeof(f_win))) feat_bad[kMainView]++;
+            if (!same(q_view, q_win, sizeof(q_win))) q_bad++;
+        }
+        recording_free(&rec);
+    }
+
+    printf("%zu amostras conferidas\n", checked);
+    bool order_ok = order_bad == 0;
+    printf("ordem cronologica das janelas: %s\n", order_ok ? "OK" : "FALHOU");
+    ok = ok && order_ok && checked > 0;
+    for (int v = 0; v < Windows::kViews; v++) {
+        bool v_ok = feat_bad[v] == 0 && (v != kMainView || q_bad == 0);
+        printf("janela %3d: features %s%s\n", Windows::kLengths[v],
+               v == kMainView ? "(float e Q8 = WindowBuffer) " : "(= lote escalar) ",
+               v_ok ? "OK" : "FALHOU");
+        ok = ok && v_ok;
+    }
+
+    size_t separate = 0;
+    for (int v = 0; v < Windows::kViews; v++) separate += (size_t)Windows::kLengths[v] * WINDOW_CHANNELS * sizeof(int16_t);
+    printf("\namostras: anel compartilhado %zu bytes | janelas separadas %zu bytes | WindowBuffer (%d) %zu bytes\n",
+           sizeof(Windows), separate, WINDOW_SIZE, sizeof(WindowBuffer));
+    printf("host: push %.1f ns | features das %d janelas %.0f ns por amostra\n",
+           push_ns / timed, Windows::kViews, feat_ns / timed);
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Teste de estresse do anel SPSC e do pipeline produtor/consumidor, com
+// std::thread no papel dos dois cores do RP2040.
+//
+//   pipeline_stress [amostras] [periodo_us] [pausa_max_us]
+//
+// O produtor codifica o número de sequência nos eixos de cada amostra; o
+// consumidor confere o conteúdo, roda a extração de features real e faz
+// pausas aleatórias para forçar o anel a encher; como o relatório de main.c,
+// lê os contadores do produtor com pipeline_stats. Retorna 1 se alguma
+// amostra chegar corrompida ou se os contadores não fecharem ou recuarem.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+extern "C" {
+#include "include/pipeline.h"
+#include "include/features.h"
+}
+
+static uint32_t now_us() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void encode(uint32_t seq, int16_t *accel, int16_t *gyro) {
+    accel[0] = (int16_t)(seq & 0x7fff);
+    accel[1] = (int16_t)((seq >> 15) & 0x7fff);
+    accel[2] = (int16_t)(seq * 7);
+    gyro[0] = (int16_t)~seq;
+    gyro[1] = (int16_t)(seq ^ 0x5a5a);
+    gyro[2] = (int16_t)(seq >> 3);
+}
+
+int main(int argc, char **argv) {
+    const uint32_t total = argc > 1 ? (uint32_t)atol(argv[1]) : 200000;
+    const uint32_t period_us = argc > 2 ? (uint32_t)atol(argv[2]) : 10;
+    const uint32_t max_stall_us = argc > 3 ? (uint32_t)atol(argv[3]) : 200;
+
+    static Pipeline pipeline;
+    pipeline_init(&pipeline, period_us, now_us());
+    std::atomic<bool> done{false};
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::thread producer([&] {
+        int16_t accel[3], gyro[3];
+        while (pipeline.seq < total) {
+            if (pipeline_time_to_next(&pipeline, now_us()) > 0) continue;
+            encode(pipeline.seq, accel, gyro);
+            pipeline_produce(&pipeline, now_us(), accel, gyro);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t corrupted = 0, regressed = 0;
+    std::thread consumer([&] {
+        static WindowBuffer win;
+        window_init(&win);
+        std::mt19937 rng(1234);
+        TimedSample s;
+        int32_t features[NUM_FEATURES];
+        PipelineStats seen = {};
+
+        while (true) {
+            if (!pipeline_consume(&pipeline, &s)) {
+                if (done.load(std::memory_order_acquire) && ring_count(&pipeline.ring) == 0) break;
+                continue;
+            }
+
+            int16_t accel[3], gyro[3];
+            encode(s.seq, accel, gyro);
+            for (int i = 0; i < 3; i++) {
+                if (accel[i] != s.accel[i] || gyro[i] != s.gyro[i]) {
+                    corrupted++;
+                    break;
+                }
+            }
+
+            PipelineStats st = pipeline_stats(&pipeline);
+            if (st.overruns < seen.overruns || st.dropped < seen.dropped) regressed++;
+            seen = st;
+
+            window_add_sample(&win, s.accel, s.gyro);
+            if (window_is_ready(&win)) extract_features_q(&win, features);
+
+            // Pausa ocasional, como um printf lento na USB
+            if (max_stall_us > 0 && (rng() & 1023) == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(rng() % max_stall_us));
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    // Descartes depois da última amostra consumida não aparecem como buraco
+    uint32_t tail_drops = pipeline.seq - pipeline.expected_seq;
+    bool ok = corrupted == 0 && regressed == 0
+           && pipeline.consumed + pipeline.dropped == pipeline.seq
+           && pipeline.gaps + tail_drops == pipeline.dropped;
+
+    printf("produzidas: %lu | consumidas: %lu | descartadas: %lu | perdidas (seq): %lu | atrasos: %lu\n",
+           (unsigned long)pipeline.seq, (unsigned long)pipeline.consumed, (unsigned long)pipeline.dropped,
+           (unsigned long)pipeline.gaps, (unsigned long)pipeline.overruns);
+    printf("corrompidas: %lu | contadores recuando: %lu | %.2f s | %.0f amostras/s\n",
+           (unsigned long)corrupted, (unsigned long)regressed, secs, pipeline.seq / secs);
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
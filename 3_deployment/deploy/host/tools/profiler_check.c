@@ -0,0 +1,107 @@
+// Confere o profiler (src/profiler.c) com um contador de ciclos simulado de
+// 24 bits, como o SysTick do RP2040 (o alvo não define HAL_HOST).
+//
+//   profiler_check
+//
+// Faixas do histograma contíguas e com erro relativo <= 25%, p50/p99 de
+// distribuições conhecidas dentro da resolução, intervalos que atravessam a
+// volta do contador, PROF_SCOPE nos returns antecipados e reset.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "include/profiler.h"
+
+static uint32_t fake_cycles;
+
+uint32_t hal_cycles(void) {
+    return fake_cycles & HAL_CYCLES_MASK;
+}
+
+uint32_t hal_cycles_per_us(void) {
+    return 125;
+}
+
+int hal_console_getchar(void) {
+    return -1;
+}
+
+static void timed(prof_stage_t stage, uint32_t cycles) {
+    prof_begin(stage);
+    fake_cycles += cycles;
+    prof_end(stage);
+}
+
+static int scoped(int early) {
+    PROF_SCOPE(PROF_OUTPUT);
+    fake_cycles += 1000;
+    if (early) return 1;
+    fake_cycles += 1000;
+    return 0;
+}
+
+static bool within(uint32_t got, uint32_t want, double tol) {
+    double err = (double)got / want - 1.0;
+    return err >= -tol && err <= tol;
+}
+
+int main(void) {
+    bool ok = true;
+    profiler_init();
+
+    /* ---------- Faixas ---------- */
+    bool bins_ok = profiler_bin(0) == 0 && profiler_bin_floor(0) == 0;
+    for (int b = 1; b < PROFILER_BINS && bins_ok; b++) {
+        uint32_t lo = profiler_bin_floor(b);
+        bins_ok = lo > profiler_bin_floor(b - 1) && profiler_bin(lo) == b && profiler_bin(lo - 1) == b - 1;
+        if (b + 1 < PROFILER_BINS && lo >= 4) {
+            uint32_t width = profiler_bin_floor(b + 1) - lo;
+            bins_ok = bins_ok && width * 4 <= lo;
+        }
+    }
+    bins_ok = bins_ok && profiler_bin(HAL_CYCLES_MASK) == PROFILER_BINS - 1;
+    printf("%d faixas, contiguas, largura <= 25%%: %s\n", PROFILER_BINS, bins_ok ? "OK" : "FALHOU");
+    ok = ok && bins_ok;
+
+    /* ---------- Percentis ---------- */
+    // 1000 medidas: 980 de 10 000 ciclos, 20 de 200 000 (caudas raras)
+    for (int i = 0; i < 1000; i++) timed(PROF_INFERENCE, i % 50 == 7 || i % 50 == 31 ? 200000 : 10000);
+    uint32_t p50 = profiler_percentile(PROF_INFERENCE, 500);
+    uint32_t p99 = profiler_percentile(PROF_INFERENCE, 990);
+    bool pct_ok = profiler_count(PROF_INFERENCE) == 1000 && within(p50, 10000, 0.13) && within(p99, 200000, 0.13);
+    printf("p50 %lu (10000) | p99 %lu (200000): %s\n", (unsigned long)p50, (unsigned long)p99,
+           pct_ok ? "OK" : "FALHOU");
+    ok = ok && pct_ok;
+
+    // Rampa uniforme 1..100 000: p50 ~ 50 000, p99 ~ 99 000
+    for (uint32_t i = 1; i <= 100000; i++) timed(PROF_FEATURES, i);
+    p50 = profiler_percentile(PROF_FEATURES, 500);
+    p99 = profiler_percentile(PROF_FEATURES, 990);
+    bool ramp_ok = within(p50, 50000, 0.13) && within(p99, 99000, 0.13);
+    printf("rampa: p50 %lu (50000) | p99 %lu (99000): %s\n", (unsigned long)p50, (unsigned long)p99,
+           ramp_ok ? "OK" : "FALHOU");
+    ok = ok && ramp_ok;
+
+    /* ---------- Volta do contador ---------- */
+    fake_cycles = HAL_CYCLES_MASK - 500;
+    timed(PROF_SENSOR, 3000);
+    bool wrap_ok = profiler_percentile(PROF_SENSOR, 500) == 3000;
+    printf("intervalo atravessando a volta de %d bits: %s\n", HAL_CYCLES_BITS, wrap_ok ? "OK" : "FALHOU");
+    ok = ok && wrap_ok;
+
+    /* ---------- PROF_SCOPE ---------- */
+    scoped(1);
+    scoped(0);
+    bool scope_ok = profiler_count(PROF_OUTPUT) == 2 && profiler_percentile(PROF_OUTPUT, 0) == 1000 &&
+                    profiler_percentile(PROF_OUTPUT, 1000) == 2000;
+    printf("PROF_SCOPE com return antecipado: %s\n", scope_ok ? "OK" : "FALHOU");
+    ok = ok && scope_ok;
+
+    profiler_dump();
+    profiler_reset();
+    bool reset_ok = profiler_count(PROF_INFERENCE) == 0 && profiler_percentile(PROF_INFERENCE, 500) == 0;
+    printf("reset: %s\n", reset_ok ? "OK" : "FALHOU");
+    ok = ok && reset_ok;
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
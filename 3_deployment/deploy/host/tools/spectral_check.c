@@ -0,0 +1,240 @@
+// Confere as features espectrais (src/spectral.cpp) sem hardware:
+//
+//   spectral_check [arquivo.csv ...]
+//
+// - ilog2_q16 contra log2 em double;
+// - espectro de potência contra uma DFT em double do mesmo sinal (média
+//   removida + Hann), em todas as janelas de data/*.csv;
+// - senoides na magnitude do accel: frequência dominante dentro de
+//   SPECTRAL_FREQ_TOL_HZ, energia concentrada na banda certa e entropia baixa;
+//   ruído branco com entropia alta;
+// - custo por janela no host, comparado com o intervalo entre inferências
+//   (WINDOW_HOP * SAMPLE_INTERVAL_MS). No dispositivo, o estágio "spectral"
+//   do profiler mede o mesmo.
+//
+// Também imprime a frequência dominante média e as bandas de cada gravação.
+// Retorna 1 se algum critério falhar.
+
+#define _DEFAULT_SOURCE
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "include/spectral.h"
+#include "include/fixed_math.h"
+#include "recording.h"
+
+#define N SPECTRAL_FFT_SIZE
+#define FS_HZ (1000.0 / SAMPLE_INTERVAL_MS)
+
+#define SPECTRAL_FREQ_TOL_HZ 0.1
+#define SPECTRAL_POWER_TOL 1e-3      // erro máximo de um bin / energia total
+#define SPECTRAL_BAND_MIN 0.85       // fração na banda da senoide
+#define SPECTRAL_SINE_ENTROPY 0.35
+#define SPECTRAL_NOISE_ENTROPY 0.85
+
+static const int band_edges_dhz[SPECTRAL_BANDS] = SPECTRAL_BAND_EDGES_DHZ;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void push(WindowBuffer *win, SpectralWindow *sw, int16_t ax, int16_t ay, int16_t az) {
+    int16_t accel[3] = { ax, ay, az }, gyro[3] = { 0, 0, 0 };
+    window_add_sample(win, accel, gyro);
+    spectral_add_sample(sw, win);
+}
+
+static bool check_log2(void) {
+    double worst = 0;
+    for (uint64_t x = 1; x < (1ull << 62); x = x * 3 + 1) {
+        double err = fabs(ilog2_q16(x) / 65536.0 - log2((double)x));
+        if (err > worst) worst = err;
+    }
+    bool ok = worst < 2.0 / 65536;
+    printf("ilog2_q16: erro maximo %.2e %s\n", worst, ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+// Potência da DFT em double, já na escala que spectral_power devolve
+static double reference_error(SpectralWindow *sw) {
+    uint64_t power[SPECTRAL_BINS];
+    int shift = spectral_power(sw, power);
+
+    uint64_t sum = 0;
+    for (int n = 0; n < N; n++) sum += sw->mag[n];
+    double mean = (double)((sum + N / 2) / N);
+
+    double x[N], ref[SPECTRAL_BINS], total = 0;
+    for (int n = 0; n < N; n++) {
+        double hann = 0.5 * (1.0 - cos(2 * M_PI * n / N));
+        x[n] = ((double)sw->mag[(sw->index + n) % N] - mean) * hann;
+    }
+    for (int k = 0; k < SPECTRAL_BINS; k++) {
+        double re = 0, im = 0;
+        for (int n = 0; n < N; n++) {
+            re += x[n] * cos(2 * M_PI * k * n / N);
+            im -= x[n] * sin(2 * M_PI * k * n / N);
+        }
+        ref[k] = (re * re + im * im) * 4.0 * ldexp(1.0, 2 * shift);
+        total += ref[k];
+    }
+    if (total == 0) return 0;
+
+    double worst = 0;
+    for (int k = 0; k < SPECTRAL_BINS; k++) {
+        double err = fabs((double)power[k] - ref[k]) / total;
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+static int band_of(double hz) {
+    int b = -1;
+    for (int i = 0; i < SPECTRAL_BANDS; i++) {
+        if (hz * 10 >= band_edges_dhz[i]) b = i;
+    }
+    return b;
+}
+
+static bool check_sines(void) {
+    const double freqs[] = { 0.8, 1.0, 1.7, 2.0, 2.3, 3.0, 4.4, 6.0, 8.5 };
+    bool ok = true;
+    printf("\n%8s %10s %8s %8s %9s\n", "f (Hz)", "medida", "erro", "banda", "entropia");
+
+    for (size_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+        static WindowBuffer win;
+        SpectralWindow sw;
+        window_init(&win);
+        spectral_init(&sw);
+        for (int n = 0; n < N + 7; n++) {
+            double v = 1500.0 * sin(2 * M_PI * freqs[i] * n / FS_HZ + 0.3 * i);
+            push(&win, &sw, 300, -200, (int16_t)lround(12000.0 + v));
+        }
+
+        int32_t f[SPECTRAL_NUM_FEATURES];
+        spectral_extract_q(&sw, f);
+        double hz = f[0] / 256.0;
+        int b = band_of(freqs[i]);
+        double in_band = b >= 0 ? f[1 + b] / 256.0 : 0.0;
+        double entropy = f[1 + SPECTRAL_BANDS] / 256.0;
+
+        bool good = fabs(hz - freqs[i]) <= SPECTRAL_FREQ_TOL_HZ && entropy <= SPECTRAL_SINE_ENTROPY;
+        // Perto de uma borda a energia se divide entre duas bandas
+        bool near_edge = false;
+        for (int e = 0; e < SPECTRAL_BANDS; e++) {
+            near_edge |= fabs(freqs[i] * 10 - band_edges_dhz[e]) < 2.0 * FS_HZ * 10 / N;
+        }
+        if (!near_edge) good = good && in_band >= SPECTRAL_BAND_MIN;
+
+        printf("%8.2f %10.3f %+8.3f %7.0f%% %9.3f %s\n", freqs[i], hz, hz - freqs[i], 100 * in_band,
+               entropy, good ? "ok" : "FALHOU");
+        ok = ok && good;
+    }
+
+    // Ruído branco (LCG): espectro plano
+    static WindowBuffer win;
+    SpectralWindow sw;
+    window_init(&win);
+    spectral_init(&sw);
+    uint32_t seed = 12345;
+    for (int n = 0; n < N; n++) {
+        seed = seed * 1664525u + 1013904223u;
+        push(&win, &sw, 0, 0, (int16_t)(12000 + (int)(seed >> 21) - 1024));
+    }
+    int32_t f[SPECTRAL_NUM_FEATURES];
+    spectral_extract_q(&sw, f);
+    double entropy = f[1 + SPECTRAL_BANDS] / 256.0;
+    bool noise_ok = entropy >= SPECTRAL_NOISE_ENTROPY;
+    printf("ruido branco: entropia %.3f %s\n", entropy, noise_ok ? "ok" : "FALHOU");
+
+    // Sinal constante: tudo zero
+    window_init(&win);
+    spectral_init(&sw);
+    for (int n = 0; n < N; n++) push(&win, &sw, 0, 0, 16384);
+    spectral_extract_q(&sw, f);
+    bool flat_ok = true;
+    for (int k = 0; k < SPECTRAL_NUM_FEATURES; k++) flat_ok = flat_ok && f[k] == 0;
+    printf("sinal constante: %s\n", flat_ok ? "ok" : "FALHOU");
+
+    return ok && noise_ok && flat_ok;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {
+        DEPLOY_DATA_DIR "/parado.csv", DEPLOY_DATA_DIR "/caminhando.csv",
+        DEPLOY_DATA_DIR "/correndo.csv", DEPLOY_DATA_DIR "/pulando.csv"
+    };
+    const char **files = argc > 1 ? (const char **)&argv[1] : defaults;
+    int num_files = argc > 1 ? argc - 1 : 4;
+
+    printf("FFT de %d pontos a %.0f Hz: %.3f Hz por bin, %d bandas\n\n", N, FS_HZ, FS_HZ / N, SPECTRAL_BANDS);
+    bool ok = check_log2();
+    ok = check_sines() && ok;
+
+    printf("\n%-12s %8s %9s", "gravacao", "janelas", "dom (Hz)");
+    for (int b = 0; b < SPECTRAL_BANDS; b++) printf("  >%4.1f Hz", band_edges_dhz[b] / 10.0);
+    printf(" %9s %10s\n", "entropia", "erro DFT");
+
+    double worst_dft = 0, secs = 0;
+    long timed = 0;
+    for (int i = 0; i < num_files; i++) {
+        Recording rec;
+        if (!recording_load(files[i], &rec)) {
+            fprintf(stderr, "nao foi possivel abrir %s\n", files[i]);
+            ok = false;
+            continue;
+        }
+
+        static WindowBuffer win;
+        SpectralWindow sw;
+        window_init(&win);
+        spectral_init(&sw);
+        double mean[SPECTRAL_NUM_FEATURES] = {0}, file_dft = 0;
+        long windows = 0;
+
+        for (size_t s = 0; s < rec.count; s++) {
+            push(&win, &sw, rec.rows[s][0], rec.rows[s][1], rec.rows[s][2]);
+            if (!spectral_is_ready(&sw) || (s + 1 - N) % WINDOW_HOP != 0) continue;
+
+            int32_t f[SPECTRAL_NUM_FEATURES];
+            double t0 = now_s();
+            spectral_extract_q(&sw, f);
+            secs += now_s() - t0;
+            timed++;
+
+            for (int k = 0; k < SPECTRAL_NUM_FEATURES; k++) mean[k] += f[k] / 256.0;
+            double err = reference_error(&sw);
+            if (err > file_dft) file_dft = err;
+            windows++;
+        }
+        if (file_dft > worst_dft) worst_dft = file_dft;
+
+        printf("%-12s %8ld", rec.label, windows);
+        for (int k = 0; k < SPECTRAL_NUM_FEATURES; k++) {
+            double v = windows ? mean[k] / windows : 0.0;
+            if (k == 0) printf(" %9.2f", v);
+            else if (k <= SPECTRAL_BANDS) printf("  %7.0f%%", 100 * v);
+            else printf(" %9.3f", v);
+        }
+        printf(" %10.1e\n", file_dft);
+        recording_free(&rec);
+    }
+
+    bool dft_ok = worst_dft <= SPECTRAL_POWER_TOL;
+    printf("\nespectro vs DFT em double: erro maximo %.1e da energia %s\n", worst_dft, dft_ok ? "ok" : "FALHOU");
+    ok = ok && dft_ok;
+
+    if (timed > 0) {
+        double per_us = secs / timed * 1e6;
+        double budget_us = WINDOW_HOP * SAMPLE_INTERVAL_MS * 1000.0;
+        printf("custo: %.2f us por janela no host (%.4f%% dos %.0f ms entre inferencias)\n", per_us,
+               100 * per_us / budget_us, budget_us / 1000);
+    }
+
+    printf(ok ? "OK\n" : "FALHOU\n");
+    return ok ? 0 : 1;
+}
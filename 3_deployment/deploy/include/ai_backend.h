@@ -0,0 +1,42 @@
+#ifndef AI_BACKEND_H
+#define AI_BACKEND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Interface entre ai_core.cpp e o motor de inferência escolhido no build:
+// src/ai_backend_tflm.cpp (interpretador TFLM), src/ai_backend_mlp.cpp
+// (kernel int8 gerado de model.h, sem interpretador nem arena) ou
+// src/ai_backend_forest.cpp (floresta de árvores gerada de forest.json).
+//
+// Cada ai_backend_t é uma instância independente do modelo (interpretador +
+// arena, ou buffers de ativação), então instâncias diferentes podem rodar
+// em paralelo. O firmware usa só a instância estática de ai_backend_default.
+
+typedef struct {
+    float input_scale;
+    int32_t input_zero_point;
+    float output_scale;
+    int32_t output_zero_point;
+} ai_backend_quant_t;
+
+typedef struct ai_backend ai_backend_t;
+
+ai_backend_t* ai_backend_default(void);
+
+// Instâncias extras alocadas no heap (host)
+ai_backend_t* ai_backend_create(void);
+void ai_backend_destroy(ai_backend_t *b);
+
+bool ai_backend_init(ai_backend_t *b, ai_backend_quant_t *quant);
+int8_t* ai_backend_input(ai_backend_t *b);
+
+// Roda o modelo sobre a entrada; retorna a saída int8 ou NULL em erro
+const int8_t* ai_backend_invoke(ai_backend_t *b);
+
+// RAM de trabalho do modelo: reservada e realmente usada após o init
+size_t ai_backend_arena_size(ai_backend_t *b);
+size_t ai_backend_arena_used(ai_backend_t *b);
+
+#endif
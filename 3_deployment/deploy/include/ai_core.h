@@ -2,14 +2,56 @@
 #define AI_CORE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "include/features.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Índices na ordem do LabelEncoder do treino (alfabética)
+typedef enum {
+    AI_ERRO = -1,
+    AI_CAMINHANDO = 0,
+    AI_CORRENDO,
+    AI_PARADO,
+    AI_PULANDO
+} ai_class_t;
+
+typedef struct {
+    ai_class_t cls;
+    uint16_t confidence;   // décimos de porcento (0..1000)
+} ai_result_t;
+
 bool ai_init(void);
+
+// Arena reservada (AI_TENSOR_ARENA_SIZE) e bytes realmente usados após ai_init
+size_t ai_arena_size_bytes(void);
+size_t ai_arena_used_bytes(void);
+
 const char* ai_run_inference(float *features, float *confidence_out);
 
+// Caminho inteiro: extract_features_int8(win, ai_input_quant(), ai_input_buffer())
+// preenche a entrada do modelo diretamente; depois chamar ai_classify.
+int8_t* ai_input_buffer(void);
+const FeatureQuant* ai_input_quant(void);
+const char* ai_run_inference_int8(float *confidence_out);
+
+// Roda o modelo sobre a entrada já preenchida; sem strings nem expf
+ai_result_t ai_classify(void);
+const char* ai_class_name(ai_class_t cls);
+
+// Instâncias extras do modelo, cada uma com seu interpretador e arena, para
+// rodar em paralelo (ex.: uma por thread no host). Chamar ai_init antes;
+// ai_input_quant vale para todas.
+typedef struct ai_backend ai_backend_t;
+
+ai_backend_t* ai_instance_create(void);
+void ai_instance_destroy(ai_backend_t *b);
+int8_t* ai_instance_input(ai_backend_t *b);
+ai_result_t ai_classify_instance(ai_backend_t *b);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,44 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "decimator_coeffs.h"
+
+// Decimação anti-aliasing dos 6 eixos do IMU, só com inteiros:
+// CIC de ordem DECIM_CIC_ORDER (razão DECIM_CIC_RATIO) seguido de um FIR de
+// fase linear que compensa a queda do CIC e decima por DECIM_FIR_RATIO.
+// Atraso de grupo: (R - 1) * N / 2 amostras de entrada + (TAPS - 1) / 2
+// amostras na taxa intermediária.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECIM_AXES 6
+
+typedef struct {
+    // CIC: integradores e pentes em aritmética modular de 32 bits
+    uint32_t integ[DECIM_CIC_ORDER][DECIM_AXES];
+    uint32_t comb[DECIM_CIC_ORDER][DECIM_AXES];
+    int cic_phase;
+
+    // FIR: linha de atraso duplicada (janela contígua sem módulo)
+    int16_t hist[DECIM_AXES][2 * DECIM_FIR_TAPS];
+    int hist_pos;
+    int fir_phase;
+} Decimator;
+
+void decimator_init(Decimator *d);
+
+// Empurra uma leitura na taxa do sensor; retorna true quando sai uma
+// amostra decimada em out_accel/out_gyro
+bool decimator_push(Decimator *d, const int16_t *accel, const int16_t *gyro,
+                    int16_t *out_accel, int16_t *out_gyro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
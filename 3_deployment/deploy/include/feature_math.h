@@ -0,0 +1,96 @@
+#ifndef FEATURE_MATH_H
+#define FEATURE_MATH_H
+
+// Contas por janela das 14 features, comuns a src/features.c (estado
+// incremental), host/features_batch.c (lote; referência dos kernels SIMD) e
+// include/multi_window.h (anel compartilhado). Quem chama só percorre as
+// amostras do seu jeito e entrega somas, extremos e trechos contíguos; a
+// semântica (sinal e ZCR / 2 do notebook, arredondamentos em Q8) fica aqui.
+
+#include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "include/features.h"
+#include "include/fixed_math.h"
+
+static inline int feat_sign3(int32_t v) {
+    return (v > 0) - (v < 0);
+}
+
+// sign(x - média) sem divisão: x - média tem o sinal de x * n - soma
+static inline int feat_sign(int16_t x, int32_t n, int32_t sum) {
+    return feat_sign3(x * n - sum);
+}
+
+// Soma de |sign(x[i] - média) - sign(x[i-1] - média)| num trecho de len
+// amostras espaçadas de stride, como np.sum(np.abs(np.diff(np.sign(x - mean))))
+// no notebook: cada cruzamento vale 2 e cada passagem por uma amostra igual à
+// média vale 1. *prev leva o sinal anterior de um trecho ao seguinte (anel que
+// deu a volta); no primeiro trecho, comece com feat_sign da primeira amostra,
+// que então compara com ela mesma e não conta.
+static inline int feat_sign_steps(const int16_t *p, size_t stride, int len, int32_t n,
+                                  int32_t sum, int *prev) {
+    int steps = 0;
+    int last = *prev;
+    for (int t = 0; t < len; t++) {
+        int cur = feat_sign(p[(size_t)t * stride], n, sum);
+        steps += cur > last ? cur - last : last - cur;
+        last = cur;
+    }
+    *prev = last;
+    return steps;
+}
+
+// Variância * n² (exata)
+static inline int64_t feat_var_n2(int64_t n, int64_t sum, int64_t sum_sq) {
+    return n * sum_sq - sum * sum;
+}
+
+// Desvio padrão a partir de variância * n²
+static inline float feat_std(float var_n2, int64_t n) {
+    return sqrtf(var_n2) / (float)n;
+}
+
+// Idem em Q8; var_n2_q é variância * n² << (2 * FEATURE_Q_FRAC_BITS)
+static inline int32_t feat_std_q(uint64_t var_n2_q, int64_t n) {
+    uint32_t root = isqrt64_round(var_n2_q);
+    return (int32_t)((root + n / 2) / n);
+}
+
+static inline float feat_range(int32_t mx, int32_t mn) {
+    return (float)(mx - mn);
+}
+
+static inline int32_t feat_range_q(int32_t mx, int32_t mn) {
+    return (mx - mn) << FEATURE_Q_FRAC_BITS;
+}
+
+// ZCR do treino = passos de sinal / 2 (número de cruzamentos)
+static inline float feat_zcr(int steps) {
+    return steps / 2.0f;
+}
+
+static inline int32_t feat_zcr_q(int steps) {
+    return steps << (FEATURE_Q_FRAC_BITS - 1);
+}
+
+// Magnitude em Q8 (soma dos quadrados em 32 bits sem sinal não estoura)
+static inline uint32_t feat_mag_q8(int16_t x, int16_t y, int16_t z) {
+    uint32_t sq = (uint32_t)(x * x) + (uint32_t)(y * y) + (uint32_t)(z * z);
+#if FEATURES_FIXED_POINT
+    return isqrt64_round((uint64_t)sq << (2 * MAG_FRAC_BITS));
+#else
+    return (uint32_t)(sqrtf((float)sq) * (1 << MAG_FRAC_BITS) + 0.5f);
+#endif
+}
+
+// Média das magnitudes Q8 de n amostras
+static inline float feat_mean_mag(uint64_t sum_mag, int64_t n) {
+    return (float)sum_mag / (float)(n << MAG_FRAC_BITS);
+}
+
+static inline int32_t feat_mean_mag_q(uint64_t sum_mag, int64_t n) {
+    return (int32_t)((sum_mag + n / 2) / n);
+}
+
+#endif
@@ -5,16 +5,82 @@
 #include <stdbool.h>
 #include "config.h"
 
+// Canais da janela (ordem das colunas dos CSVs)
+enum { CH_AX, CH_AY, CH_AZ, CH_GX, CH_GY, CH_GZ, WINDOW_CHANNELS };
+
+// Canais com feature de range (ax, ay, az)
+#define RANGE_CHANNELS 3
+
+// Magnitudes guardadas em ponto fixo Q8
+#define MAG_FRAC_BITS 8
+
+// Saída de extract_features_q: Q23.8 em int32
+#define FEATURE_Q_FRAC_BITS 8
+
+// Com FEATURES_FIXED_POINT=1 o caminho inteiro também alimenta
+// extract_features, e nenhuma feature usa float até a conversão final.
+#ifndef FEATURES_FIXED_POINT
+#define FEATURES_FIXED_POINT 0
+#endif
+
+// Garante que variância * n² << 16 caiba em 64 bits
+#if WINDOW_SIZE > 512
+#error "WINDOW_SIZE maximo e 512"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fila monotônica de posições da janela (mínimo/máximo deslizante)
+typedef struct {
+    uint16_t slot[WINDOW_SIZE];
+    uint16_t head;
+    uint16_t size;
+} MonoDeque;
+
+// Janela deslizante com estado incremental: somas, somas dos quadrados,
+// soma das magnitudes e filas de mín/máx são atualizadas a cada amostra,
+// então extract_features não precisa varrer a janela para essas features.
 typedef struct {
-    int16_t ax[WINDOW_SIZE], ay[WINDOW_SIZE], az[WINDOW_SIZE];
-    int16_t gx[WINDOW_SIZE], gy[WINDOW_SIZE], gz[WINDOW_SIZE];
-    int index;
+    int16_t samples[WINDOW_CHANNELS][WINDOW_SIZE];
+    uint32_t mag_a[WINDOW_SIZE], mag_g[WINDOW_SIZE];
+
+    int32_t sum[WINDOW_CHANNELS];
+    int64_t sum_sq[WINDOW_CHANNELS];
+    uint64_t sum_mag_a, sum_mag_g;
+    MonoDeque min_q[RANGE_CHANNELS], max_q[RANGE_CHANNELS];
+
+    int index;   // próxima posição a escrever (= amostra mais antiga quando cheia)
+    int count;   // amostras válidas (até WINDOW_SIZE)
     bool is_full;
 } WindowBuffer;
 
+// StandardScaler + quantização da entrada fundidos em inteiros:
+// q = clamp((f_q * mult + offset) >> shift, -128, 127), com f_q em Q8
+typedef struct {
+    int32_t mult;
+    int32_t shift;
+    int64_t offset;   // inclui o zero_point e o arredondamento
+} FeatureQuant;
+
 void window_init(WindowBuffer *win);
 void window_add_sample(WindowBuffer *win, int16_t *accel, int16_t *gyro);
 bool window_is_ready(WindowBuffer *win);
+
+// Com a janela ainda enchendo (count >= 2), desvio padrão e ZCR são
+// corrigidos para o comprimento WINDOW_SIZE; o range fica como medido
 void extract_features(WindowBuffer *win, float *features_out);
+void extract_features_q(WindowBuffer *win, int32_t *features_out);
+
+// Escreve as features já normalizadas e quantizadas (ex.: no tensor de entrada)
+void extract_features_int8(WindowBuffer *win, const FeatureQuant *quant, int8_t *out);
+
+// Mesma normalização a partir de features Q8 já extraídas (extract_features_q)
+void features_quantize_int8(const int32_t *features_q, const FeatureQuant *quant, int8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,48 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+// Raiz quadrada inteira (arredondada para baixo), bit a bit, sem divisões.
+static inline uint32_t isqrt64(uint64_t x) {
+    uint64_t res = 0;
+    uint64_t bit = 1ull << 62;
+
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+// Raiz quadrada inteira arredondada para o inteiro mais próximo
+static inline uint32_t isqrt64_round(uint64_t x) {
+    uint32_t r = isqrt64(x);
+    return (x - (uint64_t)r * r > r) ? r + 1 : r;
+}
+
+// log2(x) em Q16 (x >= 1; log2(0) vira 0): a parte inteira é a posição do
+// bit mais alto e a fração sai de quadrados sucessivos da mantissa em Q31
+static inline uint32_t ilog2_q16(uint64_t x) {
+    if (x == 0) return 0;
+    int e = 63 - __builtin_clzll(x);
+    uint64_t m = e >= 31 ? x >> (e - 31) : x << (31 - e);   // [2^31, 2^32)
+    uint32_t frac = 0;
+
+    for (int bit = 15; bit >= 0; bit--) {
+        m = (m * m) >> 31;
+        if (m >= (1ull << 32)) {
+            m >>= 1;
+            frac |= 1u << bit;
+        }
+    }
+    return ((uint32_t)e << 16) | frac;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef FOREST_KERNEL_H
+#define FOREST_KERNEL_H
+
+// Kernel de floresta de árvores de decisão sobre a entrada int8 do modelo.
+// Cada árvore é completada até a profundidade DEPTH (nós que já eram folha
+// viram testes que sempre vão para a esquerda), então os nós cabem em
+// arrays planos na ordem de um heap e a descida não tem desvio:
+//
+//   i = 2 * i + 1 + (x[feature[i]] > threshold[i])
+//
+// repetida DEPTH vezes, com DEPTH constante (o compilador desenrola). As
+// folhas guardam a probabilidade de cada classe em 1/255; a saída é a média
+// das árvores no formato do softmax int8 (escala 1/255, zero_point -128).
+// Os parâmetros vêm de model_forest.h, gerado por host/tools/gen_forest.py.
+
+#include <stdint.h>
+
+namespace forest {
+
+template <int DEPTH, int CLASSES>
+struct Tree {
+    static constexpr int kNodes = (1 << DEPTH) - 1;
+    static constexpr int kLeaves = 1 << DEPTH;
+
+    uint8_t feature[kNodes];
+    int8_t threshold[kNodes];   // x <= threshold desce à esquerda
+    uint8_t leaf[kLeaves][CLASSES];
+};
+
+template <int TREES, int DEPTH, int CLASSES>
+struct Forest {
+    Tree<DEPTH, CLASSES> trees[TREES];
+};
+
+template <int DEPTH, int CLASSES>
+inline const uint8_t *leaf(const Tree<DEPTH, CLASSES> &t, const int8_t *x) {
+    int i = 0;
+    for (int d = 0; d < DEPTH; d++) {
+        i = 2 * i + 1 + (x[t.feature[i]] > t.threshold[i]);
+    }
+    return t.leaf[i - Tree<DEPTH, CLASSES>::kNodes];
+}
+
+template <int TREES, int DEPTH, int CLASSES>
+inline void invoke(const Forest<TREES, DEPTH, CLASSES> &f, const int8_t *in, int8_t *out) {
+    uint32_t acc[CLASSES] = {};
+    for (int k = 0; k < TREES; k++) {
+        const uint8_t *p = leaf(f.trees[k], in);
+        for (int c = 0; c < CLASSES; c++) acc[c] += p[c];
+    }
+    for (int c = 0; c < CLASSES; c++) {
+        out[c] = (int8_t)((int32_t)((acc[c] + TREES / 2) / TREES) - 128);
+    }
+}
+
+} // namespace forest
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Camada de abstração de hardware usada pelo main.c.
+// No Pico (src/hal_pico.c) chama o Pico SDK e o driver do MPU6500;
+// no host (host/hal_host.c) reproduz os CSVs de data/ num relógio virtual.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ---------- LEDs ---------- */
+#define LED_R 13
+#define LED_G 11
+#define LED_B 12
+
+// Inicializa stdio, LEDs e I2C
+void hal_init(void);
+void hal_imu_init(void);
+
+// Falso quando a fonte de amostras terminou (somente no host)
+bool hal_running(void);
+
+uint32_t hal_millis(void);
+uint32_t hal_micros(void);
+void hal_sleep_ms(uint32_t ms);
+void hal_sleep_us(uint32_t us);
+
+// Timer de amostragem: dispara a cada period_us a partir do instante
+// retornado por hal_timer_start; hal_timer_wait dorme (WFI no RP2040) até o
+// próximo disparo e retorna o instante do despertar. Disparos vencidos
+// durante o processamento são coalescidos; hal_timer_missed conta os que
+// sobraram (amostras perdidas) desde hal_timer_start.
+uint32_t hal_timer_start(uint32_t period_us);
+uint32_t hal_timer_wait(void);
+uint32_t hal_timer_missed(void);
+
+void hal_read_imu(int16_t *accel, int16_t *gyro);
+// Lê as amostras já acumuladas pelo sensor (modo MPU6500_USE_FIFO)
+int hal_read_imu_batch(int16_t (*accel)[3], int16_t (*gyro)[3], int max_samples);
+int hal_imu_pending(void);   // amostras que ficaram no sensor após a última leitura
+
+// Barramento I2C do sensor (no host, atendido pelo simulador do MPU6500)
+int hal_i2c_write(uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int hal_i2c_read(uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+void hal_led_put(uint32_t pin, bool on);
+
+// Executa `entry` no core 1 (somente firmware, modo PIPELINE_DUAL_CORE)
+void hal_launch_core1(void (*entry)(void));
+// Campainha entre os cores (mesmo modo): hal_core_signal acorda quem está em
+// hal_core_wait, ou faz a próxima espera voltar na hora; a espera também pode
+// voltar sem sinal, então quem espera confere de novo o que aguardava
+void hal_core_signal(void);
+void hal_core_wait(void);
+
+/* ---------- Contador de ciclos (include/profiler.h) ---------- */
+// Contador livre crescente de HAL_CYCLES_BITS bits; intervalos são
+// (fim - início) & HAL_CYCLES_MASK. Pico: SysTick em clk_sys (24 bits, dá a
+// volta a cada ~134 ms a 125 MHz); host: nanossegundos do relógio real.
+#ifdef HAL_HOST
+#define HAL_CYCLES_BITS 32
+#else
+#define HAL_CYCLES_BITS 24
+#endif
+#define HAL_CYCLES_MASK ((uint32_t)(((uint64_t)1 << HAL_CYCLES_BITS) - 1))
+
+uint32_t hal_cycles(void);
+uint32_t hal_cycles_per_us(void);
+
+// Caractere recebido no console serial, sem bloquear (-1: nenhum)
+int hal_console_getchar(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef JITTER_H
+#define JITTER_H
+
+#include <stdint.h>
+
+// Contabilidade de jitter da amostragem: compara o instante de cada leitura
+// com a grade ideal do timer (primeiro disparo + k * período) e acumula um
+// histograma logarítmico do atraso. Bin 0: atraso 0; bin k: [2^(k-1), 2^k) us.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JITTER_BINS 17
+
+typedef struct {
+    uint32_t period_us;
+    uint32_t next_due_us;
+
+    uint32_t last_us;        // timestamp da última amostra
+    uint32_t samples;
+    uint32_t missed;         // períodos inteiros que passaram sem amostra
+    uint32_t max_late_us;
+    uint64_t sum_late_us;
+    uint32_t hist[JITTER_BINS];
+} JitterStats;
+
+void jitter_init(JitterStats *j, uint32_t period_us, uint32_t first_due_us);
+void jitter_record(JitterStats *j, uint32_t t_us);
+int jitter_bin(uint32_t late_us);
+void jitter_print(const JitterStats *j);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef MLP_KERNEL_H
+#define MLP_KERNEL_H
+
+// Kernel int8 de MLP (FULLY_CONNECTED + SOFTMAX) especializado nas formas
+// das camadas em tempo de compilação. Reproduz a aritmética de referência
+// do TFLM (MultiplyByQuantizedMultiplier e o softmax em ponto fixo do
+// gemmlowp), então a saída é bit a bit igual à do interpretador.
+// Os parâmetros vêm de model_mlp.h, gerado por host/tools/gen_mlp.py.
+
+#include <stdint.h>
+
+namespace mlp {
+
+/* ---------- Parâmetros das camadas ---------- */
+
+template <int IN, int OUT>
+struct Dense {
+    int8_t weights[OUT][IN];
+    int32_t bias[OUT];      // já inclui input_offset * soma dos pesos da linha
+    int32_t mult[OUT];      // multiplicador por canal (Q31)
+    int8_t shift[OUT];      // expoente por canal (>0: esquerda)
+    int32_t output_offset;
+    int32_t act_min, act_max;
+};
+
+template <int N>
+struct Softmax {
+    int32_t input_mult;
+    int32_t input_left_shift;
+    int32_t diff_min;
+};
+
+/* ---------- Aritmética de ponto fixo (gemmlowp) ---------- */
+
+inline int32_t rounding_doubling_high_mul(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) return INT32_MAX;
+    int64_t ab = (int64_t)a * b;
+    int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+    return (int32_t)((ab + nudge) / (1ll << 31));
+}
+
+inline int32_t rounding_divide_by_pot(int32_t x, int exponent) {
+    int32_t mask = (int32_t)((1ll << exponent) - 1);
+    int32_t remainder = x & mask;
+    int32_t threshold = (mask >> 1) + (x < 0 ? 1 : 0);
+    return (x >> exponent) + (remainder > threshold ? 1 : 0);
+}
+
+// x * 2^exponent com saturação (exponent > 0) ou arredondamento (< 0)
+inline int32_t saturating_rounding_mul_by_pot(int32_t x, int exponent) {
+    if (exponent < 0) return rounding_divide_by_pot(x, -exponent);
+    if (exponent == 0) return x;
+    int32_t threshold = (int32_t)((1u << (31 - exponent)) - 1);
+    if (x > threshold) return INT32_MAX;
+    if (x < -threshold) return INT32_MIN;
+    return (int32_t)((uint32_t)x << exponent);
+}
+
+inline int32_t multiply_by_quantized_multiplier(int32_t x, int32_t mult, int shift) {
+    int left = shift > 0 ? shift : 0;
+    int right = shift > 0 ? 0 : -shift;
+    return rounding_divide_by_pot(rounding_doubling_high_mul(x * (1 << left), mult), right);
+}
+
+// Valores em ponto fixo são int32 "raw" com INT bits inteiros; o produto de
+// Q(a) por Q(b) é Q(a+b) e mudar de formato é um shift saturado.
+template <int FROM, int TO>
+inline int32_t rescale(int32_t raw) {
+    return saturating_rounding_mul_by_pot(raw, FROM - TO);
+}
+
+constexpr int32_t kOneQ0 = INT32_MAX;
+
+// exp(a) para a em [-1/4, 0), Taylor em torno de -1/8; entrada e saída Q0
+inline int32_t exp_on_interval_neg_quarter(int32_t a) {
+    const int32_t constant_term = 1895147668;   // exp(-1/8)
+    const int32_t constant_1_over_3 = 715827883;
+    int32_t x = a + (1 << 28);
+    int32_t x2 = rounding_doubling_high_mul(x, x);
+    int32_t x3 = rounding_doubling_high_mul(x2, x);
+    int32_t x4 = rounding_doubling_high_mul(x2, x2);
+    int32_t x4_over_4 = rounding_divide_by_pot(x4, 2);
+    int32_t poly = rounding_divide_by_pot(
+        rounding_doubling_high_mul(x4_over_4 + x3, constant_1_over_3) + x2, 1);
+    return constant_term + rounding_doubling_high_mul(constant_term, x + poly);
+}
+
+// exp(a) para a <= 0; entrada com INT bits inteiros, saída Q0
+template <int INT>
+inline int32_t exp_on_negative_values(int32_t a) {
+    constexpr int kFrac = 31 - INT;
+    const int32_t one_quarter = 1 << (kFrac - 2);
+    const int32_t mask = one_quarter - 1;
+    int32_t a_mod_quarter_minus_one_quarter = (a & mask) - one_quarter;
+    int32_t result = exp_on_interval_neg_quarter(rescale<INT, 0>(a_mod_quarter_minus_one_quarter));
+    int32_t remainder = a_mod_quarter_minus_one_quarter - a;
+
+    // Fatores exp(-2^k) para cada bit do resto
+    static const int32_t multipliers[7] = {
+        1672461947, 1302514674, 790015084, 290630308, 39332535, 720401, 242
+    };
+    for (int k = -2; k <= 4; k++) {
+        if (INT > k && (remainder & (1 << (kFrac + k)))) {
+            result = rounding_doubling_high_mul(result, multipliers[k + 2]);
+        }
+    }
+
+    if constexpr (INT > 5) {
+        if (a < -(1 << (36 - INT))) result = 0;   // exp(< -32) = 0
+    }
+    if (a == 0) result = kOneQ0;
+    return result;
+}
+
+// 1 / (1 + x) para x em [0, 1), Newton-Raphson; entrada e saída Q0
+inline int32_t one_over_one_plus_x(int32_t a) {
+    int64_t sum = (int64_t)a + kOneQ0;
+    int32_t half_denominator = (int32_t)((sum + (sum >= 0 ? 1 : -1)) / 2);
+    const int32_t constant_48_over_17 = 1515870810;      // Q2
+    const int32_t constant_neg_32_over_17 = -1010580540; // Q2
+    const int32_t one_q2 = 1 << 29;
+
+    int32_t x = constant_48_over_17 + rounding_doubling_high_mul(half_denominator, constant_neg_32_over_17);
+    for (int i = 0; i < 3; i++) {
+        int32_t half_denominator_times_x = rounding_doubling_high_mul(half_denominator, x);
+        int32_t one_minus = one_q2 - half_denominator_times_x;
+        x = x + rescale<4, 2>(rounding_doubling_high_mul(x, one_minus));
+    }
+    return rescale<2, 0>(rounding_divide_by_pot(x, 1));
+}
+
+/* ---------- Camadas ---------- */
+
+// y = act(requant(W x + b)); IN e OUT constantes deixam o compilador
+// desenrolar o laço interno
+template <int IN, int OUT>
+inline void dense(const Dense<IN, OUT> &p, const int8_t *in, int8_t *out) {
+    for (int o = 0; o < OUT; o++) {
+        const int8_t *w = p.weights[o];
+        int32_t acc = p.bias[o];
+        for (int i = 0; i < IN; i++) {
+            acc += (int32_t)w[i] * in[i];
+        }
+        acc = multiply_by_quantized_multiplier(acc, p.mult[o], p.shift[o]) + p.output_offset;
+        if (acc < p.act_min) acc = p.act_min;
+        if (acc > p.act_max) acc = p.act_max;
+        out[o] = (int8_t)acc;
+    }
+}
+
+// Softmax int8 -> int8 (escala 1/256, zero_point -128), como
+// reference_ops::Softmax do TFLM
+template <int N>
+inline void softmax(const Softmax<N> &p, const int8_t *in, int8_t *out) {
+    constexpr int kScaledDiffIntegerBits = 5;
+    constexpr int kAccumulationIntegerBits = 12;
+
+    int8_t max_in = in[0];
+    for (int c = 1; c < N; c++) {
+        if (in[c] > max_in) max_in = in[c];
+    }
+
+    int32_t exps[N];
+    int32_t sum_of_exps = 0;   // Q12
+    for (int c = 0; c < N; c++) {
+        int32_t diff = (int32_t)in[c] - max_in;
+        exps[c] = 0;
+        if (diff >= p.diff_min) {
+            int32_t scaled = rounding_doubling_high_mul(diff * (1 << p.input_left_shift), p.input_mult);
+            exps[c] = exp_on_negative_values<kScaledDiffIntegerBits>(scaled);
+            sum_of_exps += rescale<0, kAccumulationIntegerBits>(exps[c]);
+        }
+    }
+
+    // Recíproco da soma normalizada para [1, 2)
+    int headroom_plus_one = __builtin_clz((uint32_t)sum_of_exps);
+    int num_bits_over_unit = kAccumulationIntegerBits - headroom_plus_one;
+    int32_t shifted_sum_minus_one =
+        (int32_t)(((uint32_t)sum_of_exps << headroom_plus_one) - (1u << 31));
+    int32_t shifted_scale = one_over_one_plus_x(shifted_sum_minus_one);
+
+    for (int c = 0; c < N; c++) {
+        int32_t diff = (int32_t)in[c] - max_in;
+        if (diff < p.diff_min) {
+            out[c] = -128;
+            continue;
+        }
+        int32_t v = rounding_divide_by_pot(rounding_doubling_high_mul(shifted_scale, exps[c]),
+                                           num_bits_over_unit + 31 - 8) - 128;
+        if (v > 127) v = 127;
+        if (v < -128) v = -128;
+        out[c] = (int8_t)v;
+    }
+}
+
+} // namespace mlp
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef MOTION_GATE_H
+#define MOTION_GATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "include/features.h"
+
+// Primeiro estágio da cascata: decide "parado" só com as features Q8 que
+// extract_features_q já calculou (soma dos desvios padrão do accel e do
+// gyro), em duas comparações. Janelas acima de qualquer limiar são
+// ambíguas e seguem para o modelo.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int32_t accel_std_q8;   // limiar de std_ax + std_ay + std_az
+    int32_t gyro_std_q8;    // limiar de std_gx + std_gy + std_gz
+} MotionGateThresholds;
+
+typedef struct {
+    MotionGateThresholds th;
+    uint32_t windows;   // janelas avaliadas
+    uint32_t still;     // decididas como parado sem inferência
+} MotionGate;
+
+// th NULL: limiares de config.h (MOTION_GATE_*_STD_Q8)
+void motion_gate_init(MotionGate *g, const MotionGateThresholds *th);
+
+// Estatísticas que o gate compara, a partir de extract_features_q
+void motion_gate_stats(const int32_t *features_q, int32_t *accel_std_q8, int32_t *gyro_std_q8);
+
+// true: janela parada, a inferência pode ser pulada
+bool motion_gate_is_still(MotionGate *g, const int32_t *features_q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,8 +2,40 @@
 #define MPU6500_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes por amostra no FIFO (accel + gyro, sem temperatura)
+#define MPU6500_FIFO_FRAME 12
+#define MPU6500_FIFO_SIZE 512
+#define MPU6500_FIFO_OVERFLOW (-1)
+
+typedef struct {
+    uint32_t transactions;   // rajadas de leitura do FIFO
+    uint32_t samples;        // amostras entregues
+    uint32_t overflows;      // vezes em que o FIFO estourou e foi zerado
+    uint16_t pending;        // amostras completas que ficaram após a última leitura
+} Mpu6500FifoStats;
 
 void mpu6500_init(void);
 void mpu6500_read_data(int16_t *accel, int16_t *gyro);
 
-#endif
\ No newline at end of file
+// Modo FIFO: o sensor amostra sozinho a 1 kHz / (1 + sample_rate_div)
+// e o driver drena várias amostras por transação I2C.
+void mpu6500_fifo_init(uint8_t sample_rate_div);
+void mpu6500_fifo_reset(void);
+uint16_t mpu6500_fifo_count(void);
+
+// Lê até max_samples amostras completas; retorna quantas leu ou
+// MPU6500_FIFO_OVERFLOW (o FIFO é zerado e as amostras pendentes perdidas)
+int mpu6500_fifo_read(int16_t (*accel)[3], int16_t (*gyro)[3], int max_samples);
+const Mpu6500FifoStats* mpu6500_fifo_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef MULTI_WINDOW_H
+#define MULTI_WINDOW_H
+
+// Janelas deslizantes de vários tamanhos sobre um único anel de amostras.
+//
+//   mwin::MultiWindow<6, 10, 20, 100> w;   // 6 canais, janelas de 10/20/100
+//   w.push(accel, gyro);
+//   if (w.ready(2)) mwin::features(w.view(2), f_longo);
+//
+// O anel guarda kCapacity = max(LENGTHS) amostras por canal, em SoA, e cada
+// janela é uma View das últimas N amostras: sem cópia, lida em ordem
+// cronológica como no máximo dois trechos contíguos do anel (antes e depois
+// da volta). Janelas curtas e longas dividem a mesma memória, então somar
+// uma janela de contexto custa só a diferença de tamanho, não outro buffer.
+//
+// features()/features_q() calculam as mesmas 14 features de extract_features
+// e extract_features_q (as contas de include/feature_math.h, bit a bit) para
+// qualquer View de 6 canais; elas varrem a janela, sem o estado incremental
+// de WindowBuffer.
+
+#include <stdint.h>
+#include "include/features.h"
+#include "include/feature_math.h"
+
+namespace mwin {
+
+template <int FIRST, int... REST>
+constexpr int max_of() {
+    int m = FIRST;
+    ((m = REST > m ? REST : m), ...);
+    return m;
+}
+
+/* ---------- Leitura em ordem cronológica ---------- */
+
+// Um canal de uma janela: ring[start..] e, se deu a volta, ring[0..]
+class ChannelSpan {
+public:
+    ChannelSpan(const int16_t *ring, int capacity, int start, int length)
+        : ring_(ring), capacity_(capacity), start_(start), length_(length) {}
+
+    int size() const { return length_; }
+
+    int16_t operator[](int i) const {
+        int k = start_ + i;
+        if (k >= capacity_) k -= capacity_;
+        return ring_[k];
+    }
+
+    // Trechos contíguos, na ordem: first() e depois second()
+    const int16_t *first() const { return ring_ + start_; }
+    int first_size() const { return length_ < capacity_ - start_ ? length_ : capacity_ - start_; }
+    const int16_t *second() const { return ring_; }
+    int second_size() const { return length_ - first_size(); }
+
+    template <class F>
+    void for_each(F &&f) const {
+        const int16_t *p = first();
+        for (int i = 0, n = first_size(); i < n; i++) f(p[i]);
+        for (int i = 0, n = second_size(); i < n; i++) f(ring_[i]);
+    }
+
+private:
+    const int16_t *ring_;
+    int capacity_, start_, length_;
+};
+
+// As últimas length amostras de todos os canais
+class View {
+public:
+    View(const int16_t *ring, int capacity, int channels, int start, int length)
+        : ring_(ring), capacity_(capacity), channels_(channels), start_(start), length_(length) {}
+
+    int size() const { return length_; }
+    int channels() const { return channels_; }
+
+    ChannelSpan channel(int c) const {
+        return ChannelSpan(ring_ + c * capacity_, capacity_, start_, length_);
+    }
+
+    // f(k) com a posição k do anel de cada amostra, em ordem cronológica
+    // (a mesma para todos os canais: ring(c)[k])
+    template <class F>
+    void for_each_slot(F &&f) const {
+        int k = start_;
+        for (int i = 0; i < length_; i++) {
+            f(k);
+            if (++k == capacity_) k = 0;
+        }
+    }
+
+    const int16_t *ring(int c) const { return ring_ + c * capacity_; }
+
+private:
+    const int16_t *ring_;
+    int capacity_, channels_, start_, length_;
+};
+
+/* ---------- Anel compartilhado ---------- */
+
+template <int CHANNELS, int... LENGTHS>
+class MultiWindow {
+public:
+    static constexpr int kChannels = CHANNELS;
+    static constexpr int kViews = sizeof...(LENGTHS);
+    static constexpr int kCapacity = max_of<LENGTHS...>();
+    static constexpr int kLengths[kViews] = { LENGTHS... };
+
+    static_assert(CHANNELS > 0, "MultiWindow precisa de ao menos um canal");
+    static_assert(((LENGTHS > 0) && ...), "tamanhos de janela precisam ser positivos");
+    // Mesmo limite de WINDOW_SIZE: x * n em 32 bits e variância * n² << 16 em 64
+    static_assert(kCapacity <= 512, "janela maxima e 512 amostras");
+
+    void reset() {
+        head_ = 0;
+        filled_ = 0;
+    }
+
+    void push(const int16_t *sample) {
+        for (int c = 0; c < CHANNELS; c++) ring_[c][head_] = sample[c];
+        if (++head_ == kCapacity) head_ = 0;
+        if (filled_ < kCapacity) filled_++;
+    }
+
+    // Mesma assinatura de window_add_sample (ax, ay, az, gx, gy, gz)
+    void push(const int16_t *accel, const int16_t *gyro) {
+        static_assert(CHANNELS == WINDOW_CHANNELS, "push(accel, gyro) e para janelas de 6 canais");
+        int16_t s[WINDOW_CHANNELS] = { accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2] };
+        push(s);
+    }
+
+    // Janela v cheia (já recebeu kLengths[v] amostras)
+    bool ready(int v) const { return filled_ >= kLengths[v]; }
+
+    // Últimas kLengths[v] amostras (ou todas, antes de encher)
+    View view(int v) const {
+        int length = kLengths[v] < filled_ ? kLengths[v] : filled_;
+        int start = head_ - length;
+        if (start < 0) start += kCapacity;
+        return View(&ring_[0][0], kCapacity, CHANNELS, start, length);
+    }
+
+    template <int V>
+    View view() const {
+        static_assert(V >= 0 && V < kViews, "indice de janela invalido");
+        return view(V);
+    }
+
+private:
+    int16_t ring_[CHANNELS][kCapacity] = {};
+    int head_ = 0;     // próxima posição a escrever
+    int filled_ = 0;   // amostras válidas (até kCapacity)
+};
+
+/* ---------- Features sobre uma View de 6 canais ---------- */
+
+struct ChannelStats {
+    int32_t sum;
+    int64_t sum_sq;
+    int16_t min, max;
+};
+
+inline ChannelStats channel_stats(const ChannelSpan &s) {
+    ChannelStats st = { 0, 0, INT16_MAX, INT16_MIN };
+    s.for_each([&](int16_t x) {
+        st.sum += x;
+        st.sum_sq += (int32_t)x * x;
+        if (x < st.min) st.min = x;
+        if (x > st.max) st.max = x;
+    });
+    return st;
+}
+
+// feat_sign_steps nos dois trechos do anel (ZCR = passos / 2)
+inline int channel_sign_steps(const ChannelSpan &s, int32_t sum) {
+    const int32_t n = s.size();
+    int prev = feat_sign(s[0], n, sum);
+    int steps = feat_sign_steps(s.first(), 1, s.first_size(), n, sum, &prev);
+    return steps + feat_sign_steps(s.second(), 1, s.second_size(), n, sum, &prev);
+}
+
+// Soma das magnitudes Q8 (feat_mag_q8) dos canais c, c+1, c+2
+inline uint64_t sum_magnitude_q8(const View &v, int c) {
+    const int16_t *x = v.ring(c), *y = v.ring(c + 1), *z = v.ring(c + 2);
+    uint64_t sum = 0;
+    v.for_each_slot([&](int k) { sum += feat_mag_q8(x[k], y[k], z[k]); });
+    return sum;
+}
+
+// Q8 como extract_features_q; v.size() > 0
+inline void features_q(const View &v, int32_t *f) {
+    const int64_t n = v.size();
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        ChannelSpan s = v.channel(ch);
+        ChannelStats st = channel_stats(s);
+        uint64_t var_n2 = (uint64_t)feat_var_n2(n, st.sum, st.sum_sq);
+        f[ch] = feat_std_q(var_n2 << (2 * FEATURE_Q_FRAC_BITS), n);
+        if (ch < RANGE_CHANNELS) {
+            f[8 + ch] = feat_range_q(st.max, st.min);
+            f[11 + ch] = feat_zcr_q(channel_sign_steps(s, st.sum));
+        }
+    }
+    f[6] = feat_mean_mag_q(sum_magnitude_q8(v, CH_AX), n);
+    f[7] = feat_mean_mag_q(sum_magnitude_q8(v, CH_GX), n);
+}
+
+// Como extract_features (caminho float ou ponto fixo, conforme o build)
+inline void features(const View &v, float *f) {
+#if FEATURES_FIXED_POINT
+    int32_t q[NUM_FEATURES];
+    features_q(v, q);
+    for (int i = 0; i < NUM_FEATURES; i++) {
+        f[i] = (float)q[i] * (1.0f / (1 << FEATURE_Q_FRAC_BITS));
+    }
+#else
+    const int64_t n = v.size();
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        ChannelSpan s = v.channel(ch);
+        ChannelStats st = channel_stats(s);
+        f[ch] = feat_std((float)feat_var_n2(n, st.sum, st.sum_sq), n);
+        if (ch < RANGE_CHANNELS) {
+            f[8 + ch] = feat_range(st.max, st.min);
+            f[11 + ch] = feat_zcr(channel_sign_steps(s, st.sum));
+        }
+    }
+    f[6] = feat_mean_mag(sum_magnitude_q8(v, CH_AX), n);
+    f[7] = feat_mean_mag(sum_magnitude_q8(v, CH_GX), n);
+#endif
+}
+
+} // namespace mwin
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "include/sample_ring.h"
+
+// Produtor/consumidor de amostras entre os dois cores.
+// Os contadores de cada lado só são escritos pelo core dono dele; o outro
+// core lê com pipeline_stats.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    SampleRing ring;
+
+    // Produtor (core 1)
+    uint32_t period_us;
+    uint32_t next_due_us;
+    uint32_t seq;
+    uint32_t overruns;   // amostragens atrasadas mais de um período
+    uint32_t dropped;    // amostras descartadas com o anel cheio
+
+    // Consumidor (core 0)
+    uint32_t expected_seq;
+    uint32_t gaps;       // amostras que o consumidor nunca viu
+    uint32_t consumed;
+} Pipeline;
+
+void pipeline_init(Pipeline *p, uint32_t period_us, uint32_t now_us);
+
+// Produtor: tempo a esperar até a próxima amostra (0 = ler agora)
+uint32_t pipeline_time_to_next(Pipeline *p, uint32_t now_us);
+// Produtor: publica a leitura e agenda a próxima
+void pipeline_produce(Pipeline *p, uint32_t t_us, const int16_t *accel, const int16_t *gyro);
+
+// Consumidor: retira a próxima amostra, contabilizando buracos de sequência
+bool pipeline_consume(Pipeline *p, TimedSample *out);
+
+// Contadores de perda lidos de qualquer core (cada um atômico, não o conjunto)
+typedef struct {
+    uint32_t overruns, dropped, gaps;
+} PipelineStats;
+
+PipelineStats pipeline_stats(const Pipeline *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "include/hal.h"
+
+// Profiler por estágio do loop, para medir no próprio dispositivo onde vai
+// o orçamento de cada amostra. O tempo vem de hal_cycles() (SysTick em
+// clk_sys no Pico, nanossegundos no host); cada estágio guarda contagem,
+// mín/máx/soma e um histograma logarítmico de tamanho fixo (4 faixas por
+// oitava, ~20% de resolução) de onde saem p50 e p99. Tudo em memória
+// estática; com PROFILER_ENABLE=0 as macros somem e nada é compilado.
+//
+// Pelo console serial: 'p' imprime a tabela, 'r' zera (profiler_poll no
+// loop principal). Só o core 0 deve medir.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PROF_PROCESS,     // process_sample inteiro (janela + features + modelo + saída)
+    PROF_SENSOR,
+    PROF_DECIMATE,
+    PROF_WINDOW,
+    PROF_FEATURES,
+    PROF_INFERENCE,
+    PROF_OUTPUT,
+    PROF_SPECTRAL,    // features espectrais (SPECTRAL_ENABLE)
+    PROF_STAGE_COUNT
+} prof_stage_t;
+
+#if PROFILER_ENABLE
+
+// 4 faixas por oitava até o maior intervalo que o contador representa
+#define PROFILER_BINS (4 * (HAL_CYCLES_BITS - 1))
+
+void profiler_init(void);
+void profiler_reset(void);
+void profiler_dump(void);
+void profiler_poll(void);   // trata um comando pendente no console
+
+void prof_begin(prof_stage_t stage);
+void prof_end(prof_stage_t stage);
+
+// Estatísticas em ciclos (para ferramentas e testes no host)
+uint32_t profiler_count(prof_stage_t stage);
+uint32_t profiler_percentile(prof_stage_t stage, uint32_t permille);
+int profiler_bin(uint32_t cycles);
+uint32_t profiler_bin_floor(int bin);
+
+typedef struct {
+    prof_stage_t stage;
+} prof_scope_t;
+
+static inline prof_scope_t prof_scope_begin(prof_stage_t stage) {
+    prof_begin(stage);
+    prof_scope_t s = { stage };
+    return s;
+}
+
+static inline void prof_scope_end(prof_scope_t *s) {
+    prof_end(s->stage);
+}
+
+// Mede do ponto da declaração até o fim do bloco, inclusive nos returns
+#define PROF_SCOPE(stage) \
+    __attribute__((cleanup(prof_scope_end), unused)) prof_scope_t prof_scope_##stage = prof_scope_begin(stage)
+#define PROF_BEGIN(stage) prof_begin(stage)
+#define PROF_END(stage) prof_end(stage)
+
+#else
+
+#define profiler_init() ((void)0)
+#define profiler_reset() ((void)0)
+#define profiler_dump() ((void)0)
+#define profiler_poll() ((void)0)
+#define PROF_SCOPE(stage)
+#define PROF_BEGIN(stage) ((void)0)
+#define PROF_END(stage) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+// Anel lock-free de um produtor e um consumidor (SPSC).
+// `head` só é escrito pelo produtor e `tail` só pelo consumidor; os índices
+// crescem livremente e são mascarados no acesso.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (SAMPLE_RING_SIZE & (SAMPLE_RING_SIZE - 1)) != 0
+#error "SAMPLE_RING_SIZE deve ser potencia de 2"
+#endif
+
+typedef struct {
+    uint32_t seq;       // número da amostra no produtor
+    uint32_t t_us;      // instante da leitura
+    int16_t accel[3];
+    int16_t gyro[3];
+} TimedSample;
+
+typedef struct {
+    TimedSample buf[SAMPLE_RING_SIZE];
+    uint32_t head;
+    uint32_t tail;
+} SampleRing;
+
+void ring_init(SampleRing *ring);
+bool ring_push(SampleRing *ring, const TimedSample *sample);  // falso se cheio
+bool ring_pop(SampleRing *ring, TimedSample *sample);         // falso se vazio
+uint32_t ring_count(const SampleRing *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
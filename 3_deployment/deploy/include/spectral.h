@@ -0,0 +1,60 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "include/features.h"
+
+// Features espectrais da magnitude do accel, só com inteiros: média
+// removida, janela de Hann, FFT real radix-2 de SPECTRAL_FFT_SIZE pontos
+// (uma FFT complexa de N/2 pontos + separação) com twiddles Q15 gerados em
+// tempo de compilação. O espectro útil vai da primeira borda de banda até
+// Nyquist; abaixo dela fica a deriva lenta, que não é cadência.
+//
+// Saída em Q8 (FEATURE_Q_FRAC_BITS), na ordem:
+//   [0]                  frequência dominante em Hz (interpolação parabólica)
+//   [1 .. SPECTRAL_BANDS] fração da energia útil em cada banda (256 = tudo)
+//   [SPECTRAL_BANDS + 1] entropia espectral normalizada (256 = espectro plano)
+// Um sinal sem variação dá tudo zero.
+
+#if (SPECTRAL_FFT_SIZE & (SPECTRAL_FFT_SIZE - 1)) != 0 || SPECTRAL_FFT_SIZE < 8 || SPECTRAL_FFT_SIZE > 1024
+#error "SPECTRAL_FFT_SIZE deve ser potencia de 2 entre 8 e 1024"
+#endif
+
+#define SPECTRAL_BINS (SPECTRAL_FFT_SIZE / 2 + 1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Últimas SPECTRAL_FFT_SIZE magnitudes do accel (Q8), em anel, e o rascunho
+// da FFT: fica aqui e não na pilha (a do core 0 do Pico tem 2 KB)
+typedef struct {
+    uint32_t mag[SPECTRAL_FFT_SIZE];
+    uint16_t index;   // próxima posição a escrever (= mais antiga quando cheio)
+    uint16_t count;
+    int32_t re[SPECTRAL_FFT_SIZE / 2], im[SPECTRAL_FFT_SIZE / 2];
+    uint64_t power[SPECTRAL_BINS];
+} SpectralWindow;
+
+void spectral_init(SpectralWindow *sw);
+
+// Chamar logo depois de window_add_sample: reaproveita a magnitude que a
+// janela acabou de calcular
+void spectral_add_sample(SpectralWindow *sw, const WindowBuffer *win);
+void spectral_push(SpectralWindow *sw, uint32_t mag_q8);
+bool spectral_is_ready(const SpectralWindow *sw);
+
+void spectral_extract_q(SpectralWindow *sw, int32_t *features_out);
+void spectral_extract(SpectralWindow *sw, float *features_out);
+
+// Espectro de potência dos bins 0..N/2 na escala interna: o sinal é
+// normalizado por 2^shift antes da FFT (shift retornado, pode ser negativo)
+// e cada bin sai multiplicado por 4 * 2^(2 * shift)
+int spectral_power(SpectralWindow *sw, uint64_t *power);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
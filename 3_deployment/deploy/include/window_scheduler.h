@@ -0,0 +1,49 @@
+#ifndef WINDOW_SCHEDULER_H
+#define WINDOW_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "include/features.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Dispara extração de features + inferência apenas a cada `hop` amostras
+// depois que a janela enche, como o STRIDE usado no treinamento.
+//
+// Modo antecipado (scheduler_set_anytime): enquanto a janela enche, depois
+// de um boot ou de scheduler_reset, também dispara com `min_samples`
+// amostras e a cada `step` amostras a partir daí, marcando `provisional`.
+// scheduler_settle encerra esses disparos quando o resultado provisório já
+// basta; a primeira janela cheia dispara de qualquer forma.
+typedef struct {
+    WindowBuffer win;
+    int hop;
+    int since_fire;
+    int min_samples;   // 0: só janelas cheias
+    int step;
+    bool full_fired;   // já disparou com a janela cheia
+    bool settled;      // sem disparos provisórios até a janela encher
+    bool provisional;  // o último disparo foi com a janela parcial
+    uint32_t fired;    // inferências executadas (inclui as provisórias)
+    uint32_t early;    // disparos com a janela parcial
+    uint32_t skipped;  // amostras com janela pronta sem inferência
+} WindowScheduler;
+
+void scheduler_init(WindowScheduler *s, int hop);
+void scheduler_set_hop(WindowScheduler *s, int hop);
+void scheduler_set_anytime(WindowScheduler *s, int min_samples, int step);
+
+// Esvazia a janela (ex.: stream reiniciado), mantendo hop, modo e contadores
+void scheduler_reset(WindowScheduler *s);
+void scheduler_settle(WindowScheduler *s);
+
+// Retorna true quando a amostra fecha uma janela que deve ser processada
+bool scheduler_add_sample(WindowScheduler *s, int16_t *accel, int16_t *gyro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,109 +1,251 @@
 #include <stdio.h>
-#include <string.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
 
 #include "config.h"
-#include "include/mpu6500.h"
-#include "include/features.h"
-#include "include/ai_core.h" 
-
-/* ---------- LEDs ---------- */
-#define LED_R 13
-#define LED_G 11
-#define LED_B 12
+#include "include/hal.h"
+#include "include/window_scheduler.h"
+#include "include/ai_core.h"
+#include "include/jitter.h"
+#include "include/motion_gate.h"
+#include "include/profiler.h"
+#if SPECTRAL_ENABLE
+#include "include/spectral.h"
+#endif
+#if DECIMATOR_ENABLE
+#include "include/decimator.h"
+#endif
+#if PIPELINE_DUAL_CORE
+#include "include/pipeline.h"
+#endif
 
 static inline void set_led(bool r, bool g, bool b) {
-    gpio_put(LED_R, r);
-    gpio_put(LED_G, g);
-    gpio_put(LED_B, b);
+    hal_led_put(LED_R, r);
+    hal_led_put(LED_G, g);
+    hal_led_put(LED_B, b);
 }
 
-int main() {
-    stdio_init_all();
-
-    /* ---------- Inicialização dos LEDs ---------- */
-    gpio_init(LED_R);
-    gpio_set_dir(LED_R, GPIO_OUT);
-
-    gpio_init(LED_G);
-    gpio_set_dir(LED_G, GPIO_OUT);
+/* ---------- Variáveis ---------- */
+static WindowScheduler janela;
+static MotionGate gate;
+#if DECIMATOR_ENABLE
+static Decimator decimador;
+#endif
+#if SPECTRAL_ENABLE
+static SpectralWindow espectro;
+#endif
+
+#if PIPELINE_DUAL_CORE
+static Pipeline pipeline;
+
+/* ---------- Core 1: amostragem ---------- */
+static void core1_sampler(void) {
+    int16_t accel[3], gyro[3];
 
-    gpio_init(LED_B);
-    gpio_set_dir(LED_B, GPIO_OUT);
+    while (true) {
+        uint32_t wait = pipeline_time_to_next(&pipeline, hal_micros());
+        if (wait > 0) {
+            hal_sleep_us(wait);
+            continue;
+        }
 
-    set_led(false, false, false);
+        hal_read_imu(accel, gyro);
+        pipeline_produce(&pipeline, hal_micros(), accel, gyro);
+        hal_core_signal();
+    }
+}
+#endif
+
+/* ---------- Processamento de uma amostra ---------- */
+static void process_sample(int16_t *accel, int16_t *gyro) {
+    PROF_SCOPE(PROF_PROCESS);
+
+    /* Adicionar à janela */
+    PROF_BEGIN(PROF_WINDOW);
+    bool processar = scheduler_add_sample(&janela, accel, gyro);
+#if SPECTRAL_ENABLE
+    spectral_add_sample(&espectro, &janela.win);
+#endif
+    PROF_END(PROF_WINDOW);
+
+    /* Processar a cada WINDOW_HOP amostras com a janela cheia (ou antes, com
+       a janela enchendo, no modo antecipado) */
+    if (!processar) return;
+
+    PROF_BEGIN(PROF_FEATURES);
+    int32_t features[NUM_FEATURES];
+    extract_features_q(&janela.win, features);
+    PROF_END(PROF_FEATURES);
+
+    /* Parado pelo gate de movimento: sem inferência e sem confiança */
+    bool pelo_gate = MOTION_GATE_ENABLE && motion_gate_is_still(&gate, features);
+    ai_result_t resultado = { AI_PARADO, 0 };
+    if (!pelo_gate) {
+        PROF_BEGIN(PROF_INFERENCE);
+        features_quantize_int8(features, ai_input_quant(), ai_input_buffer());
+        resultado = ai_classify();
+        PROF_END(PROF_INFERENCE);
+    }
 
-    /* ---------- Inicialização I2C ---------- */
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
+    /* Provisório confiante (só o modelo decide): sem mais disparos até a
+       janela encher */
+    if (janela.provisional && !pelo_gate && resultado.confidence >= ANYTIME_CONFIDENCE) {
+        scheduler_settle(&janela);
+    }
+    const char *marca = janela.provisional ? " [provisorio]" : "";
+    char confianca[12] = "[gate]";
+    if (!pelo_gate) {
+        snprintf(confianca, sizeof(confianca), "(%u.%u%%)", (unsigned)(resultado.confidence / 10),
+                 (unsigned)(resultado.confidence % 10));
+    }
 
-    sleep_ms(2000);
-    printf("Sistema em C iniciando...\n");
+#if SPECTRAL_ENABLE
+    /* Cadência: frequência dominante da magnitude do accel */
+    int32_t espectrais[SPECTRAL_NUM_FEATURES] = {0};
+    if (spectral_is_ready(&espectro)) {
+        PROF_BEGIN(PROF_SPECTRAL);
+        spectral_extract_q(&espectro, espectrais);
+        PROF_END(PROF_SPECTRAL);
+    }
+#endif
+
+    PROF_BEGIN(PROF_OUTPUT);
+#if SPECTRAL_ENABLE
+    printf("Atividade: %s %s%s | cadencia %u.%02u Hz\n", ai_class_name(resultado.cls), confianca, marca,
+           (unsigned)(espectrais[0] >> 8), (unsigned)((espectrais[0] & 0xff) * 100 >> 8));
+#else
+    printf("Atividade: %s %s%s\n", ai_class_name(resultado.cls), confianca, marca);
+#endif
+
+    /* Feedback por LED */
+    switch (resultado.cls) {
+        case AI_PARADO:     set_led(true, false, false); break;
+        case AI_CAMINHANDO: set_led(false, true, false); break;
+        case AI_CORRENDO:   set_led(false, false, true); break;
+        case AI_PULANDO:    set_led(true, true, false);  break;
+        default:            set_led(false, false, false); break;
+    }
+    PROF_END(PROF_OUTPUT);
+}
 
-    /* ---------- Inicialização dos módulos ---------- */
-    mpu6500_init();
+/* ---------- Leitura na taxa do sensor ---------- */
+static void feed_sample(int16_t *accel, int16_t *gyro) {
+#if DECIMATOR_ENABLE
+    int16_t dec_accel[3], dec_gyro[3];
+    PROF_BEGIN(PROF_DECIMATE);
+    bool pronta = decimator_push(&decimador, accel, gyro, dec_accel, dec_gyro);
+    PROF_END(PROF_DECIMATE);
+    if (pronta) process_sample(dec_accel, dec_gyro);
+#else
+    process_sample(accel, gyro);
+#endif
+}
 
-    ai_init();
+int main() {
+    /* ---------- Inicialização dos periféricos ---------- */
+    hal_init();
+    profiler_init();
 
-    /* ---------- Variáveis ---------- */
-    WindowBuffer janela;
-    window_init(&janela);
+    set_led(false, false, false);
 
-    int16_t accel[3], gyro[3];
-    float features[NUM_FEATURES];
+    hal_sleep_ms(2000);
+    printf("Sistema em C iniciando...\n");
 
-    uint32_t last_time = 0;
+    /* ---------- Inicialização dos módulos ---------- */
+    hal_imu_init();
 
+    if (!ai_init()) {
+        printf("Erro ao iniciar o modelo (arena de %u bytes)\n", (unsigned)ai_arena_size_bytes());
+        return 1;
+    }
+    printf("Arena: %u de %u bytes usados\n",
+           (unsigned)ai_arena_used_bytes(), (unsigned)ai_arena_size_bytes());
+
+    scheduler_init(&janela, WINDOW_HOP);
+#if ANYTIME_ENABLE
+    scheduler_set_anytime(&janela, ANYTIME_MIN_SAMPLES, ANYTIME_STEP);
+#endif
+    motion_gate_init(&gate, NULL);
+#if SPECTRAL_ENABLE
+    spectral_init(&espectro);
+#endif
+#if DECIMATOR_ENABLE
+    decimator_init(&decimador);
+#endif
+
+#if PROFILER_ENABLE
+    printf("Perfil: envie 'p' para imprimir e 'r' para zerar\n");
+#endif
     printf("Loop iniciado!\n");
 
-    /* ---------- Loop principal ---------- */
-    while (true) {
-        uint32_t now = to_ms_since_boot(get_absolute_time());
+#if PIPELINE_DUAL_CORE
+    /* ---------- Loop principal: core 0 consome o anel ---------- */
+    pipeline_init(&pipeline, SENSOR_INTERVAL_US, hal_micros());
+    hal_launch_core1(core1_sampler);
 
-        if (now - last_time >= SAMPLE_INTERVAL_MS) {
-            last_time = now;
+    TimedSample amostra;
+    uint32_t last_report = 0;
 
-            /* Ler sensor */
-            mpu6500_read_data(accel, gyro);
+    while (hal_running()) {
+        // Dorme até o core 1 publicar, em vez de conferir a cada 1 ms
+        if (!pipeline_consume(&pipeline, &amostra)) {
+            hal_core_wait();
+            continue;
+        }
 
-            /* Adicionar à janela */
-            window_add_sample(&janela, accel, gyro);
+        feed_sample(amostra.accel, amostra.gyro);
+        profiler_poll();
 
-            /* Processar quando a janela estiver cheia */
-            if (window_is_ready(&janela)) {
-                extract_features(&janela, features);
+        PipelineStats st = pipeline_stats(&pipeline);
+        if (st.overruns + st.dropped + st.gaps != last_report) {
+            last_report = st.overruns + st.dropped + st.gaps;
+            printf("Pipeline: atrasos %lu | descartadas %lu | perdidas %lu\n",
+                   (unsigned long)st.overruns, (unsigned long)st.dropped,
+                   (unsigned long)st.gaps);
+        }
+    }
+#elif MPU6500_USE_FIFO
+    /* ---------- Loop principal: rajadas do FIFO do sensor ---------- */
+    static int16_t lote_accel[MPU6500_FIFO_BATCH][3], lote_gyro[MPU6500_FIFO_BATCH][3];
 
-                float confianca = 0.0f;
-                const char* atividade = ai_run_inference(features, &confianca);
+    while (hal_running()) {
+        PROF_BEGIN(PROF_SENSOR);
+        int n = hal_read_imu_batch(lote_accel, lote_gyro, MPU6500_FIFO_BATCH);
+        PROF_END(PROF_SENSOR);
 
-                printf("Atividade: %s (%.1f%%)\n", atividade, confianca);
+        for (int i = 0; i < n; i++) {
+            feed_sample(lote_accel[i], lote_gyro[i]);
+        }
+        profiler_poll();
 
-                /* Feedback por LED */
-                if (strcmp(atividade, "parado") == 0) {
-                    set_led(true, false, false);
+        /* Dorme enquanto o sensor acumula o próximo lote */
+        if (hal_imu_pending() == 0) {
+            hal_sleep_us((uint32_t)MPU6500_FIFO_BATCH * SENSOR_INTERVAL_US);
+        }
+    }
+#else
+    /* ---------- Loop principal: acorda só no timer de amostragem ---------- */
+    int16_t accel[3], gyro[3];
+    JitterStats jitter;
+    jitter_init(&jitter, SENSOR_INTERVAL_US, hal_timer_start(SENSOR_INTERVAL_US));
 
-                } else if (strcmp(atividade, "caminhando") == 0) {
-                    set_led(false, true, false);
+    while (hal_running()) {
+        jitter_record(&jitter, hal_timer_wait());
 
-                } else if (strcmp(atividade, "correndo") == 0) {
-                    set_led(false, false, true);
+        /* Ler sensor */
+        PROF_BEGIN(PROF_SENSOR);
+        hal_read_imu(accel, gyro);
+        PROF_END(PROF_SENSOR);
 
-                } else if (strcmp(atividade, "pulando") == 0) {
-                    set_led(true, true, false);
+        feed_sample(accel, gyro);
+        profiler_poll();
+    }
 
-                } else {
-                    set_led(false, false, false);
-                }
-            }
-        }
+    jitter_print(&jitter);
+    printf("Timer: %lu disparos coalescidos\n", (unsigned long)hal_timer_missed());
+#endif
 
-        /* Pequeno delay para reduzir uso de CPU */
-        sleep_ms(1);
-    }
+    printf("Inferencias: %lu | puladas: %lu | evitadas pelo gate: %lu | antecipadas: %lu\n",
+           (unsigned long)(janela.fired - gate.still), (unsigned long)janela.skipped,
+           (unsigned long)gate.still, (unsigned long)janela.early);
 
     return 0;
 }
@@ -0,0 +1,101 @@
+// Gerado por host/tools/gen_forest.py a partir de forest.json - nao editar.
+// Floresta de 8 arvores completadas ate a profundidade 4 para include/forest_kernel.h.
+
+#ifndef MODEL_FOREST_H
+#define MODEL_FOREST_H
+
+#include "include/forest_kernel.h"
+
+namespace model_forest {
+
+constexpr float kInputScale = 0.0337199569;
+constexpr int32_t kInputZeroPoint = 1;
+constexpr float kOutputScale = 1.0f / 255;
+constexpr int32_t kOutputZeroPoint = -128;
+constexpr int kInputSize = 14;
+constexpr int kOutputSize = 4;
+constexpr int kTrees = 8;
+constexpr int kDepth = 4;
+
+constexpr forest::Forest<kTrees, kDepth, kOutputSize> kForest = {{
+    // Arvore 0
+    {
+        {3, 9, 0, 0, 0, 6, 10, 0, 0, 0, 0, 0, 1, 1, 9},
+        {-25, -19, -2, 127, 127, -16, 32, 127, 127, 127, 127, 127, -21, -9, 81},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0},
+            {0, 0, 0, 255}, {0, 0, 0, 255}, {222, 0, 33, 0}, {254, 1, 0, 0}, {255, 0, 0, 0}, {0, 250, 0, 5}, {0, 0, 0, 255}, {0, 255, 0, 0},
+        },
+    },
+    // Arvore 1
+    {
+        {7, 0, 9, 0, 0, 6, 2, 0, 0, 0, 0, 0, 5, 6, 0},
+        {-28, 127, -3, 127, 127, -19, 21, 127, 127, 127, 127, 127, -25, -90, 127},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0},
+            {0, 0, 0, 255}, {0, 0, 0, 255}, {57, 0, 198, 0}, {248, 4, 3, 1}, {0, 0, 0, 255}, {3, 252, 0, 0}, {0, 0, 0, 255}, {0, 0, 0, 255},
+        },
+    },
+    // Arvore 2
+    {
+        {3, 10, 0, 7, 0, 10, 10, 0, 7, 0, 0, 2, 6, 7, 9},
+        {-24, -22, -2, -28, 127, -6, 32, 127, -27, 127, 127, -20, -16, -6, 81},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {96, 0, 159, 0}, {0, 0, 255, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0},
+            {175, 0, 80, 0}, {255, 0, 0, 0}, {0, 0, 0, 255}, {0, 219, 0, 36}, {108, 98, 0, 49}, {0, 253, 0, 2}, {0, 0, 0, 255}, {0, 255, 0, 0},
+        },
+    },
+    // Arvore 3
+    {
+        {2, 5, 9, 9, 4, 4, 5, 0, 4, 3, 0, 0, 6, 2, 2},
+        {-20, -22, -3, -20, -23, -7, 15, 127, -23, -27, 127, 127, -3, 18, 20},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {128, 0, 128, 0}, {0, 0, 255, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0},
+            {255, 0, 0, 0}, {255, 0, 0, 0}, {0, 0, 0, 255}, {0, 226, 0, 29}, {13, 239, 0, 2}, {0, 0, 0, 255}, {0, 254, 0, 1}, {0, 0, 0, 255},
+        },
+    },
+    // Arvore 4
+    {
+        {7, 6, 4, 0, 0, 10, 13, 0, 0, 0, 0, 0, 1, 2, 2},
+        {-27, -3, -8, 127, 127, -24, -29, 127, 127, 127, 127, 127, 4, 20, 21},
+        {
+            {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0},
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {254, 1, 0, 0}, {0, 255, 0, 0}, {0, 205, 0, 50}, {0, 0, 0, 255}, {0, 255, 0, 0}, {0, 0, 0, 255},
+        },
+    },
+    // Arvore 5
+    {
+        {7, 6, 4, 0, 3, 10, 2, 0, 0, 0, 0, 0, 5, 0, 0},
+        {-27, -1, -7, 127, -20, -24, 21, 127, 127, 127, 127, 127, 10, -3, 127},
+        {
+            {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {32, 0, 223, 0}, {32, 0, 223, 0},
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {253, 2, 0, 0}, {0, 255, 0, 0}, {0, 51, 0, 204}, {0, 251, 0, 4}, {0, 0, 0, 255}, {0, 0, 0, 255},
+        },
+    },
+    // Arvore 6
+    {
+        {7, 0, 2, 0, 0, 0, 5, 0, 0, 0, 0, 3, 7, 0, 0},
+        {-28, 127, 20, 127, 127, -1, 46, 127, 127, 127, 127, -26, -8, 127, 127},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0},
+            {0, 0, 255, 0}, {248, 2, 2, 3}, {146, 109, 0, 0}, {0, 252, 0, 3}, {0, 0, 0, 255}, {0, 0, 0, 255}, {0, 36, 0, 219}, {0, 36, 0, 219},
+        },
+    },
+    // Arvore 7
+    {
+        {3, 1, 2, 7, 0, 4, 5, 0, 8, 0, 0, 7, 6, 0, 0},
+        {-24, -19, 20, -26, 127, -7, 47, 127, -25, 127, 127, -27, -90, 127, 127},
+        {
+            {0, 0, 255, 0}, {0, 0, 255, 0}, {0, 0, 255, 0}, {73, 0, 182, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0}, {255, 0, 0, 0},
+            {56, 0, 199, 0}, {252, 3, 0, 0}, {0, 0, 0, 255}, {0, 255, 0, 0}, {0, 0, 0, 255}, {0, 0, 0, 255}, {0, 51, 0, 204}, {0, 51, 0, 204},
+        },
+    },
+}};
+
+inline void invoke(const int8_t *input, int8_t *output) {
+    forest::invoke(kForest, input, output);
+}
+
+} // namespace model_forest
+
+#endif
@@ -0,0 +1,145 @@
+// Gerado por host/tools/gen_mlp.py a partir de model.h - nao editar.
+// Pesos, bias e multiplicadores do MLP int8 para include/mlp_kernel.h.
+
+#ifndef MODEL_MLP_H
+#define MODEL_MLP_H
+
+#include "include/mlp_kernel.h"
+
+namespace model_mlp {
+
+constexpr float kInputScale = 0.03371995687484741;
+constexpr int32_t kInputZeroPoint = 1;
+constexpr float kOutputScale = 0.00390625;
+constexpr int32_t kOutputZeroPoint = -128;
+constexpr int kInputSize = 14;
+constexpr int kOutputSize = 4;
+
+// Camada 0: sequential_2_1/dense_3_1/MatMul (14 -> 32)
+constexpr mlp::Dense<14, 32> kDense0 = {
+    {
+        {81, -29, 127, 78, 63, 77, -63, 0, 46, 50, -16, -63, 3, -80},
+        {20, 102, 122, 33, 43, -57, -66, -65, -81, 11, 127, 76, -33, -49},
+        {38, 44, 35, 4, 70, 127, -15, 90, -50, -55, 71, 33, -91, 80},
+        {36, -3, -2, 95, -39, -3, -33, 96, -27, -93, -127, -35, 10, -74},
+        {-33, -54, 42, -66, 16, -127, -12, -78, -75, 35, -10, -18, 10, 7},
+        {87, 52, 127, -76, -9, -79, 14, -9, -48, 40, 77, 23, 40, -71},
+        {-36, -127, -82, -87, -110, -86, 12, -119, 44, -86, -18, -8, 28, 74},
+        {11, -77, 11, -14, 3, -127, 105, -94, 52, -99, -87, -22, 49, 95},
+        {60, -72, 127, 0, -10, -37, -64, -5, 56, 19, 114, 35, -48, -24},
+        {27, -28, 127, 85, 103, -98, -37, -32, 123, -72, 81, -59, -35, -3},
+        {-16, -48, 5, -41, 47, 38, -31, 52, -22, -118, -127, -11, -103, 70},
+        {11, -119, 122, -98, -35, 1, 41, 90, 41, -73, 127, -95, -38, -73},
+        {-66, 111, -110, 118, -3, 22, 90, 37, 4, 95, -127, -55, 34, 108},
+        {-24, 81, 127, -22, -17, -55, -37, -42, 57, -55, 121, 19, -24, -44},
+        {76, 64, -46, 3, -26, 104, 29, 24, -51, 71, -127, -20, -36, 52},
+        {-16, 38, 56, 41, 127, -94, 5, 91, -126, -103, -13, -52, -18, -123},
+        {13, 47, -120, 18, 39, 122, 21, 56, -70, -48, -96, -32, -29, -127},
+        {-127, -76, 0, -43, -27, 17, -106, -83, -52, 30, 56, 24, 11, 27},
+        {24, 59, -127, 54, -94, 85, 62, 84, 77, -79, 73, -59, 104, 64},
+        {85, 2, 42, 120, -94, 116, -21, -66, 5, 120, -127, -37, -64, 119},
+        {-100, -127, -81, -66, -28, -12, 27, 15, 55, -112, 70, 68, -26, 78},
+        {52, -33, -81, 18, -12, -26, 5, 127, -46, 2, 13, -118, -2, -21},
+        {85, 8, -122, 60, -57, 19, 43, 98, 7, 63, -127, 49, -6, 5},
+        {118, 19, -127, 31, 122, 19, 68, -39, 14, -11, -77, -71, 1, -42},
+        {6, -75, -79, 89, -127, 56, 51, 78, 88, 98, -67, 81, 98, 12},
+        {19, 57, 125, 19, 112, -53, -127, 12, 92, 67, 0, -10, 1, -27},
+        {-4, -110, -20, -83, -35, -126, -7, -33, -95, 61, -127, -63, 25, 67},
+        {71, 29, -94, 90, -33, -38, 1, 111, 60, 40, -80, 35, -22, 127},
+        {22, -54, -60, -4, -75, 34, 6, 127, 3, 65, -75, -7, -5, -81},
+        {-23, -37, 41, -127, -49, -31, -65, -113, 45, 11, 51, 20, 47, 24},
+        {-84, 92, 26, -95, 21, 52, -3, 127, -87, 110, 26, 32, -103, -17},
+        {54, -17, 13, -127, 49, -109, 37, -116, -120, 59, 103, 6, 33, 24},
+    },
+    {
+        382, -1459, 2476, 1214, 370, -1110, 687, -2066,
+        -77, -2288, 1715, 271, 1091, -843, 1706, 1188,
+        1757, 1220, 19, -60, -1590, 571, 2818, 2044,
+        1150, -1006, 782, 1440, 1740, -2309, 3090, -2011,
+    },
+    {
+        2051927567, 1161756873, 1616194490, 1902183939, 1260158738, 1740693519, 1478108288, 1464054258,
+        2051183092, 1262685881, 1367597252, 1504370162, 1377360088, 2001454358, 1959951870, 1195387501,
+        1645218962, 1606251831, 1402717049, 1593357772, 1420453813, 1596304244, 1640262472, 1626355957,
+        1441327165, 1286444157, 1798890855, 2012331498, 2101272784, 1794875856, 1317943644, 1431913239,
+    },
+    {
+        -7, -7, -7, -7, -6, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7,
+        -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7,
+    },
+    -128, -128, 127,
+};
+
+// Camada 1: sequential_2_1/dense_4_1/MatMul (32 -> 16)
+constexpr mlp::Dense<32, 16> kDense1 = {
+    {
+        {115, -18, 127, -15, -92, -91, -107, -109, -7, -67, 7, -16, 78, -52, 98, 47, -18, -1, -32, 92, -63, 49, -4, 117, 49, 69, -98, 45, -14, 1, -23, 2},
+        {-14, -100, -85, 117, 75, -72, -19, -39, -68, -16, 53, 33, 46, -55, 34, 66, 59, -32, -21, 109, 19, 19, 22, 68, 4, -9, 95, 127, 118, 56, 66, -93},
+        {8, -11, -118, -106, 43, 56, 2, 61, -30, 53, 50, -102, -94, -72, -9, -59, -71, 67, -42, -13, 79, -78, -39, 10, -66, -72, 66, -127, -114, 106, -54, -5},
+        {-65, 31, -115, 91, 107, -43, 123, 127, -26, -9, 105, 8, -64, -112, 61, 16, 62, 88, 9, -75, 90, 76, 16, 42, 62, -9, 76, 72, -30, -38, -112, -35},
+        {44, 47, -37, -37, -91, -89, -84, 14, -9, -42, 47, -64, 70, -68, 43, 6, 44, -127, 12, 54, -59, -36, 90, 70, 65, -36, -58, 14, 75, 21, -21, -42},
+        {17, 39, -16, -121, 11, -60, 80, 70, -52, 45, -24, -102, -88, -79, 65, -6, -56, -22, -20, 63, 28, 0, -68, 46, 47, -13, -19, -45, -73, 76, -15, 127},
+        {-45, -104, -69, 39, 85, -55, 63, 8, -21, -90, 68, 43, 27, -27, -42, 42, -7, -25, -61, -19, -4, 76, 118, 92, 53, 19, 54, 21, 127, 24, -27, -8},
+        {54, 70, 16, -48, 91, -8, -37, 59, 102, -4, 8, 45, -57, 97, -83, 33, -107, 1, 45, -34, 6, -7, -11, -29, -33, 21, 74, -55, -127, 101, 30, 77},
+        {-2, 51, 91, 88, -23, -24, 7, -6, 37, 10, -21, 62, 16, -23, 104, 78, 35, 19, 45, 33, -25, 63, 107, 94, 30, -11, 1, 63, 127, -57, 88, -56},
+        {-66, 6, 44, -12, 3, 20, -23, 96, -11, 14, 11, -79, -21, 42, -29, -21, -47, 106, -52, -14, 3, -69, -45, -30, 9, -3, 76, -35, -127, 52, -79, 49},
+        {86, 21, 57, -7, 2, 88, -59, 3, 75, 127, -23, 1, -18, 8, -20, 18, -26, -57, 72, 3, -23, -17, 14, 46, 7, 94, -44, 47, -6, -77, 102, 42},
+        {-47, -34, 121, 1, -112, 80, -68, -47, 71, -17, -44, -61, -23, -38, 12, -60, 96, -17, 7, 127, -103, 31, -9, 34, 126, 81, -67, 97, 2, -34, 120, 76},
+        {-43, -72, 40, 32, 57, 63, 64, -49, 35, -26, -56, -126, 80, 13, -114, -46, 38, -72, 84, 24, 86, -76, 11, -95, -98, -66, -56, 51, 45, -30, -7, 127},
+        {17, -68, 31, -6, -13, -91, -71, 11, 2, -32, -13, -84, 97, 22, 100, 50, 44, -127, 71, 5, 12, -24, 114, 82, -51, -30, -48, 82, 4, 30, -11, 3},
+        {62, 25, -30, -27, 52, 27, 64, -34, 71, 95, 9, 92, 40, 109, -71, -13, -78, 117, -80, -40, 64, -101, -3, 17, -49, 75, -5, -70, -127, 109, -64, 12},
+        {39, 82, -23, -13, 5, 46, -2, -46, 59, 14, 43, 127, -90, 78, -78, 85, 77, 42, -60, 9, 30, -18, 28, 17, -72, 40, -26, 40, 77, 2, 86, -26},
+    },
+    {
+        10542, 75779, -88943, 69756, -21759, -21934, 48564, 35458,
+        131044, -30463, 69633, 40882, -25594, 13789, 30065, 73255,
+    },
+    {
+        1737991930, 1134574205, 1172599683, 2074143479, 1216338917, 1096981280, 1082887648, 1127621289,
+        1508071085, 1299731410, 1235154148, 1774097863, 1773358984, 1084756631, 2110645256, 1177652830,
+    },
+    {
+        -9, -8, -8, -9, -8, -8, -8, -8, -8, -8, -8, -9, -9, -8, -9, -8,
+    },
+    -128, -128, 127,
+};
+
+// Camada 2: sequential_2_1/dense_5_1/MatMul (16 -> 4)
+constexpr mlp::Dense<16, 4> kDense2 = {
+    {
+        {-95, -1, 1, 16, -72, -64, 90, -38, 38, -11, -127, -98, -45, -41, -24, 20},
+        {86, -70, 15, -104, 94, 0, 13, -106, 26, -114, 85, 55, 45, 93, -127, -37},
+        {-79, -50, 100, 12, -103, 49, 77, 46, -122, 80, 15, -127, 46, -35, 77, -40},
+        {30, -127, -43, -110, -71, -92, -90, 72, 15, 13, 97, 0, -15, -30, 105, 75},
+    },
+    {
+        -56790, -6146, -7830, -22304,
+    },
+    {
+        1266170295, 1866235391, 1096524537, 2106559368,
+    },
+    {
+        -8, -9, -8, -9,
+    },
+    29, -128, 127,
+};
+
+constexpr mlp::Softmax<4> kSoftmax = { 1150131712, 24, -124 };
+
+// Ativações intermediárias
+struct Scratch {
+    int8_t a0[32];
+    int8_t a1[16];
+    int8_t a2[4];
+};
+
+inline void invoke(const int8_t *input, int8_t *output, Scratch &s) {
+    mlp::dense(kDense0, input, s.a0);
+    mlp::dense(kDense1, s.a0, s.a1);
+    mlp::dense(kDense2, s.a1, s.a2);
+    mlp::softmax(kSoftmax, s.a2, output);
+}
+
+} // namespace model_mlp
+
+#endif
@@ -0,0 +1,51 @@
+#include "include/ai_backend.h"
+#include "model_forest.h"
+
+// Floresta gerada (host/tools/gen_forest.py): nós e folhas em flash, sem
+// multiplicações; a entrada int8 é a mesma do MLP
+struct ai_backend {
+    int8_t input[model_forest::kInputSize];
+    int8_t output[model_forest::kOutputSize];
+};
+
+namespace {
+    ai_backend default_backend;
+}
+
+ai_backend_t* ai_backend_default(void) {
+    return &default_backend;
+}
+
+ai_backend_t* ai_backend_create(void) {
+    return new ai_backend();
+}
+
+void ai_backend_destroy(ai_backend_t *b) {
+    delete b;
+}
+
+bool ai_backend_init(ai_backend_t *b, ai_backend_quant_t *quant) {
+    (void)b;
+    quant->input_scale = model_forest::kInputScale;
+    quant->input_zero_point = model_forest::kInputZeroPoint;
+    quant->output_scale = model_forest::kOutputScale;
+    quant->output_zero_point = model_forest::kOutputZeroPoint;
+    return true;
+}
+
+int8_t* ai_backend_input(ai_backend_t *b) {
+    return b->input;
+}
+
+const int8_t* ai_backend_invoke(ai_backend_t *b) {
+    model_forest::invoke(b->input, b->output);
+    return b->output;
+}
+
+size_t ai_backend_arena_size(ai_backend_t *b) {
+    return sizeof(*b);
+}
+
+size_t ai_backend_arena_used(ai_backend_t *b) {
+    return ai_backend_arena_size(b);
+}
@@ -0,0 +1,53 @@
+#include "include/ai_backend.h"
+#include "model_mlp.h"
+
+// Kernel MLP gerado (python3 host/tools/gen_mlp.py): pesos em flash,
+// só as ativações em RAM
+struct ai_backend {
+    int8_t input[model_mlp::kInputSize];
+    int8_t output[model_mlp::kOutputSize];
+    model_mlp::Scratch scratch;
+};
+
+namespace {
+    ai_backend default_backend;
+}
+
+ai_backend_t* ai_backend_default(void) {
+    return &default_backend;
+}
+
+ai_backend_t* ai_backend_create(void) {
+    return new ai_backend();
+}
+
+void ai_backend_destroy(ai_backend_t *b) {
+    delete b;
+}
+
+bool ai_backend_init(ai_backend_t *b, ai_backend_quant_t *quant) {
+    (void)b;
+    quant->input_scale = model_mlp::kInputScale;
+    quant->input_zero_point = model_mlp::kInputZeroPoint;
+    quant->output_scale = model_mlp::kOutputScale;
+    quant->output_zero_point = model_mlp::kOutputZeroPoint;
+    return true;
+}
+
+int8_t* ai_backend_input(ai_backend_t *b) {
+    return b->input;
+}
+
+const int8_t* ai_backend_invoke(ai_backend_t *b) {
+    model_mlp::invoke(b->input, b->output, b->scratch);
+    return b->output;
+}
+
+// Sem arena: só os buffers de ativação
+size_t ai_backend_arena_size(ai_backend_t *b) {
+    return sizeof(*b);
+}
+
+size_t ai_backend_arena_used(ai_backend_t *b) {
+    return ai_backend_arena_size(b);
+}
@@ -0,0 +1,85 @@
+#include "include/ai_backend.h"
+#include "config.h"
+#include "model.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include <new>
+
+// Cada instância tem seu interpretador e sua arena; modelo e resolver são
+// só lidos depois de montados e ficam compartilhados
+struct ai_backend {
+    tflite::MicroInterpreter* interpreter;
+    TfLiteTensor* input;
+    TfLiteTensor* output;
+    alignas(tflite::MicroInterpreter) uint8_t interpreter_mem[sizeof(tflite::MicroInterpreter)];
+    alignas(16) uint8_t tensor_arena[AI_TENSOR_ARENA_SIZE];
+};
+
+namespace {
+    const tflite::Model* model = nullptr;
+    tflite::MicroMutableOpResolver<4> resolver;
+    ai_backend default_backend;
+
+    void build_resolver(void) {
+        if (model != nullptr) return;
+        model = tflite::GetModel(model_data);
+        resolver.AddFullyConnected();
+        resolver.AddRelu();
+        resolver.AddSoftmax();
+        resolver.AddQuantize();
+    }
+}
+
+ai_backend_t* ai_backend_default(void) {
+    return &default_backend;
+}
+
+ai_backend_t* ai_backend_create(void) {
+    ai_backend_t *b = new ai_backend;
+    b->interpreter = nullptr;
+    return b;
+}
+
+void ai_backend_destroy(ai_backend_t *b) {
+    if (b->interpreter != nullptr) b->interpreter->~MicroInterpreter();
+    delete b;
+}
+
+bool ai_backend_init(ai_backend_t *b, ai_backend_quant_t *quant) {
+    build_resolver();
+
+    if (b->interpreter == nullptr) {
+        b->interpreter = new (b->interpreter_mem) tflite::MicroInterpreter(
+            model, resolver, b->tensor_arena, sizeof(b->tensor_arena));
+    }
+    
+    if (b->interpreter->AllocateTensors() != kTfLiteOk) return false;
+    
+    b->input = b->interpreter->input(0);
+    b->output = b->interpreter->output(0);
+
+    quant->input_scale = b->input->params.scale;
+    quant->input_zero_point = b->input->params.zero_point;
+    quant->output_scale = b->output->params.scale;
+    quant->output_zero_point = b->output->params.zero_point;
+    return true;
+}
+
+int8_t* ai_backend_input(ai_backend_t *b) {
+    return b->input->data.int8;
+}
+
+const int8_t* ai_backend_invoke(ai_backend_t *b) {
+    if (b->interpreter->Invoke() != kTfLiteOk) return nullptr;
+    return b->output->data.int8;
+}
+
+size_t ai_backend_arena_size(ai_backend_t *b) {
+    return sizeof(b->tensor_arena);
+}
+
+// Pico de uso do AllocateTensors (tensores persistentes + temporários)
+size_t ai_backend_arena_used(ai_backend_t *b) {
+    return b->interpreter != nullptr ? b->interpreter->arena_used_bytes() : 0;
+}
@@ -1,8 +1,6 @@
 #include "include/ai_core.h"
-#include "model.h"
-#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
-#include "tensorflow/lite/micro/micro_interpreter.h"
-#include "tensorflow/lite/schema/schema_generated.h"
+#include "include/ai_backend.h"
+#include "config.h"
 #include <cmath>
 
 // Configurações do Scaler 
@@ -42,77 +40,134 @@ const float SCALER_SCALE[14] = {
 
 const char* CLASSES[] = { "caminhando", "correndo", "parado", "pulando" };
 
-// Variáveis Globais do TFLite
 namespace {
-    const tflite::Model* model = nullptr;
-    tflite::MicroInterpreter* interpreter = nullptr;
-    TfLiteTensor* input = nullptr;
-    TfLiteTensor* output = nullptr;
-    uint8_t tensor_arena[12 * 1024];
+    ai_backend_quant_t quant;
+
+    // Scaler + quantização da entrada, calculados uma vez em ai_init
+    FeatureQuant input_quant[14];
+
+    // Probabilidade (décimos de %) para cada valor int8 da saída
+    uint16_t confidence_lut[256];
+}
+
+// real = 1 / (SCALER_SCALE * input_scale * 2^FEATURE_Q_FRAC_BITS) vira mult * 2^-shift,
+// com mult em [2^29, 2^30); o offset absorve a média, o zero_point e o arredondamento.
+static void build_input_quant(float in_scale, int32_t in_zero_point) {
+    for (int i = 0; i < 14; i++) {
+        double step = (double)SCALER_SCALE[i] * in_scale;
+        double real = 1.0 / (step * (1 << FEATURE_Q_FRAC_BITS));
+        int exp;
+        double m = std::frexp(real, &exp);
+        int64_t mult = std::llround(m * (1ll << 30));
+        int32_t shift = 30 - exp;
+        if (mult == (1ll << 30)) {
+            mult >>= 1;
+            shift--;
+        }
+
+        double bias = in_zero_point - SCALER_MEAN[i] / step;
+        input_quant[i].mult = (int32_t)mult;
+        input_quant[i].shift = shift;
+        input_quant[i].offset = std::llround(std::ldexp(bias, shift)) + (1ll << (shift - 1));
+    }
+}
+
+static void build_confidence_lut(float out_scale, int32_t out_zero_point) {
+    for (int i = 0; i < 256; i++) {
+        float p = ((i - 128) - out_zero_point) * out_scale * 1000.0f;
+        if (p < 0.0f) p = 0.0f;
+        if (p > 1000.0f) p = 1000.0f;
+        confidence_lut[i] = (uint16_t)(p + 0.5f);
+    }
 }
 
 extern "C" bool ai_init(void) {
-    model = tflite::GetModel(model_data);
-    
-    static tflite::MicroMutableOpResolver<4> resolver;
-    resolver.AddFullyConnected();
-    resolver.AddRelu();
-    resolver.AddSoftmax();
-    resolver.AddQuantize();
-    
-    static tflite::MicroInterpreter static_interpreter(
-        model, resolver, tensor_arena, sizeof(tensor_arena));
-    interpreter = &static_interpreter;
-    
-    if (interpreter->AllocateTensors() != kTfLiteOk) return false;
-    
-    input = interpreter->input(0);
-    output = interpreter->output(0);
+    if (!ai_backend_init(ai_backend_default(), &quant)) return false;
+
+    build_input_quant(quant.input_scale, quant.input_zero_point);
+    build_confidence_lut(quant.output_scale, quant.output_zero_point);
     return true;
 }
 
+extern "C" size_t ai_arena_size_bytes(void) {
+    return ai_backend_arena_size(ai_backend_default());
+}
+
+extern "C" size_t ai_arena_used_bytes(void) {
+    return ai_backend_arena_used(ai_backend_default());
+}
+
+extern "C" int8_t* ai_input_buffer(void) {
+    return ai_backend_input(ai_backend_default());
+}
+
+extern "C" ai_backend_t* ai_instance_create(void) {
+    ai_backend_t* b = ai_backend_create();
+    ai_backend_quant_t q;
+    if (!ai_backend_init(b, &q)) {
+        ai_backend_destroy(b);
+        return nullptr;
+    }
+    return b;
+}
+
+extern "C" void ai_instance_destroy(ai_backend_t* b) {
+    ai_backend_destroy(b);
+}
+
+extern "C" int8_t* ai_instance_input(ai_backend_t* b) {
+    return ai_backend_input(b);
+}
+
+extern "C" const FeatureQuant* ai_input_quant(void) {
+    return input_quant;
+}
+
 extern "C" const char* ai_run_inference(float *features, float *confidence_out) {
     //Normalizar e Quantizar
-    int8_t* in_data = input->data.int8;
+    int8_t* in_data = ai_backend_input(ai_backend_default());
     for (int i = 0; i < 14; i++) {
         float norm = (features[i] - SCALER_MEAN[i]) / SCALER_SCALE[i];
-        int32_t q = (int32_t)(norm / input->params.scale) + input->params.zero_point;
-        if(q < -128) q = -128; if(q > 127) q = 127;
+        // Arredonda (meio para cima) como features_quantize_int8; o limite
+        // vem antes da conversão para int8
+        float q = std::floor(norm / quant.input_scale + 0.5f) + quant.input_zero_point;
+        if (q < -128.0f) q = -128.0f;
+        if (q > 127.0f) q = 127.0f;
         in_data[i] = (int8_t)q;
     }
 
+    return ai_run_inference_int8(confidence_out);
+}
+
+extern "C" ai_result_t ai_classify(void) {
+    return ai_classify_instance(ai_backend_default());
+}
+
+extern "C" ai_result_t ai_classify_instance(ai_backend_t* b) {
+    ai_result_t result = { AI_ERRO, 0 };
+
     //Rodar Modelo
-    if (interpreter->Invoke() != kTfLiteOk) return "Erro";
+    const int8_t* out_data = ai_backend_invoke(b);
+    if (out_data == nullptr) return result;
 
-    //Processar Saída
-    int8_t* out_data = output->data.int8;
-    float max_score = -1000.0f;
+    // A saída já é o softmax quantizado: basta o argmax e a tabela de confiança
     int max_idx = 0;
-    float probs[4];
-    float sum = 0;
-
-    // Dequantizar
-    for(int i=0; i<4; i++) {
-        float val = (out_data[i] - output->params.zero_point) * output->params.scale;
-        if(val > max_score) max_score = val;
-        probs[i] = val;
-    }
-    
-    // Softmax simplificado
-    for(int i=0; i<4; i++) {
-        probs[i] = expf(probs[i] - max_score);
-        sum += probs[i];
-    }
-    
-    float best_conf = 0;
-    for(int i=0; i<4; i++) {
-        probs[i] /= sum;
-        if(probs[i] > best_conf) {
-            best_conf = probs[i];
-            max_idx = i;
-        }
+    for (int i = 1; i < NUM_CLASSES; i++) {
+        if (out_data[i] > out_data[max_idx]) max_idx = i;
     }
 
-    *confidence_out = best_conf * 100.0f;
-    return CLASSES[max_idx];
-}
\ No newline at end of file
+    result.cls = (ai_class_t)max_idx;
+    result.confidence = confidence_lut[(uint8_t)(out_data[max_idx] + 128)];
+    return result;
+}
+
+extern "C" const char* ai_class_name(ai_class_t cls) {
+    if (cls < 0 || cls >= NUM_CLASSES) return "Erro";
+    return CLASSES[cls];
+}
+
+extern "C" const char* ai_run_inference_int8(float *confidence_out) {
+    ai_result_t result = ai_classify();
+    *confidence_out = result.confidence / 10.0f;
+    return ai_class_name(result.cls);
+}
@@ -0,0 +1,70 @@
+#include "include/decimator.h"
+#include <string.h>
+
+#if DECIM_GEN_INPUT_RATE_HZ != DECIM_INPUT_RATE_HZ || DECIM_GEN_CIC_RATIO != DECIM_CIC_RATIO || \
+    DECIM_GEN_CIC_ORDER != DECIM_CIC_ORDER || DECIM_GEN_FIR_RATIO != DECIM_FIR_RATIO
+#error "decimator_coeffs.h nao corresponde a config.h: rode host/tools/gen_decimator.py"
+#endif
+
+void decimator_init(Decimator *d) {
+    memset(d, 0, sizeof(*d));
+}
+
+static inline int16_t sat16(int32_t v) {
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+// Pentes do CIC na taxa reduzida e normalização por R^N
+static void cic_output(Decimator *d, int16_t *out) {
+    for (int a = 0; a < DECIM_AXES; a++) {
+        uint32_t v = d->integ[DECIM_CIC_ORDER - 1][a];
+        for (int k = 0; k < DECIM_CIC_ORDER; k++) {
+            uint32_t prev = d->comb[k][a];
+            d->comb[k][a] = v;
+            v -= prev;
+        }
+        int64_t scaled = (int64_t)(int32_t)v * DECIM_CIC_NORM_MULT;
+        out[a] = sat16((int32_t)((scaled + (1ll << (DECIM_CIC_NORM_SHIFT - 1))) >> DECIM_CIC_NORM_SHIFT));
+    }
+}
+
+bool decimator_push(Decimator *d, const int16_t *accel, const int16_t *gyro,
+                    int16_t *out_accel, int16_t *out_gyro) {
+    /* ---------- Integradores (taxa do sensor) ---------- */
+    for (int a = 0; a < DECIM_AXES; a++) {
+        uint32_t v = (uint32_t)(int32_t)(a < 3 ? accel[a] : gyro[a - 3]);
+        for (int k = 0; k < DECIM_CIC_ORDER; k++) {
+            d->integ[k][a] += v;
+            v = d->integ[k][a];
+        }
+    }
+    if (++d->cic_phase < DECIM_CIC_RATIO) return false;
+    d->cic_phase = 0;
+
+    /* ---------- Pentes e linha de atraso do FIR ---------- */
+    int16_t mid[DECIM_AXES];
+    cic_output(d, mid);
+
+    d->hist_pos = d->hist_pos == 0 ? DECIM_FIR_TAPS - 1 : d->hist_pos - 1;
+    for (int a = 0; a < DECIM_AXES; a++) {
+        d->hist[a][d->hist_pos] = mid[a];
+        d->hist[a][d->hist_pos + DECIM_FIR_TAPS] = mid[a];
+    }
+    if (++d->fir_phase < DECIM_FIR_RATIO) return false;
+    d->fir_phase = 0;
+
+    /* ---------- FIR só nas amostras que saem ---------- */
+    for (int a = 0; a < DECIM_AXES; a++) {
+        const int16_t *x = &d->hist[a][d->hist_pos];   // x[0] = mais recente
+        int32_t acc = 0;
+        for (int k = 0; k < DECIM_FIR_TAPS; k++) {
+            acc += (int32_t)decim_fir_coeffs[k] * x[k];
+        }
+        int16_t y = sat16((acc + (1 << 14)) >> 15);
+        if (a < 3) out_accel[a] = y;
+        else out_gyro[a - 3] = y;
+    }
+    return true;
+}
@@ -1,59 +1,146 @@
 #include "include/features.h"
-#include <math.h>
+#include "include/feature_math.h"
 #include <string.h>
 
-// Funções matemáticas auxiliares
-static float calc_mean(int16_t *data, int len) {
-    float sum = 0;
-    for(int i=0; i<len; i++) sum += data[i];
-    return sum / len;
-}
-
-static float calc_std(int16_t *data, int len) {
-    float mean = calc_mean(data, len);
-    float sum_sq = 0;
-    for(int i=0; i<len; i++) {
-        float diff = data[i] - mean;
-        sum_sq += diff * diff;
+// Filas monotônicas: guardam posições da janela cujos valores são
+// decrescentes (máximo) ou crescentes (mínimo); a frente é o extremo atual.
+static inline uint16_t deque_back(const MonoDeque *q) {
+    return q->slot[(q->head + q->size - 1) % WINDOW_SIZE];
+}
+
+static inline uint16_t deque_front(const MonoDeque *q) {
+    return q->slot[q->head];
+}
+
+static void deque_evict(MonoDeque *q, int slot) {
+    if (q->size > 0 && deque_front(q) == slot) {
+        q->head = (q->head + 1) % WINDOW_SIZE;
+        q->size--;
     }
-    return sqrtf(sum_sq / len);
 }
 
-static float calc_range(int16_t *data, int len) {
-    int16_t min = data[0], max = data[0];
-    for(int i=1; i<len; i++) {
-        if(data[i] < min) min = data[i];
-        if(data[i] > max) max = data[i];
+static void deque_push(MonoDeque *q, const int16_t *data, int slot, bool is_max) {
+    int16_t v = data[slot];
+    while (q->size > 0) {
+        int16_t back = data[deque_back(q)];
+        if (is_max ? (back > v) : (back < v)) break;
+        q->size--;
     }
-    return (float)(max - min);
+    q->slot[(q->head + q->size) % WINDOW_SIZE] = (uint16_t)slot;
+    q->size++;
 }
 
-static float calc_zcr(int16_t *data, int len) {
-    float mean = calc_mean(data, len);
-    int crossings = 0;
-    for(int i=1; i<len; i++) {
-        if (((data[i-1] - mean) > 0) != ((data[i] - mean) > 0)) {
-            crossings++;
-        }
+// Janela parcial (classificação antecipada): a variância de n amostras tende
+// a (n - 1) / n da real, contra (WINDOW_SIZE - 1) / WINDOW_SIZE na janela
+// cheia; a razão abaixo leva o desvio ao que a janela cheia mediria
+#define PARTIAL_VAR_NUM(n) ((uint64_t)(n) * (WINDOW_SIZE - 1))
+#define PARTIAL_VAR_DEN(n) ((uint64_t)((n) - 1) * WINDOW_SIZE)
+
+// Funções matemáticas auxiliares
+#if !FEATURES_FIXED_POINT
+static float calc_std(const WindowBuffer *win, int ch) {
+    int64_t n = win->count;
+    float var = (float)feat_var_n2(n, win->sum[ch], win->sum_sq[ch]);
+    if (!win->is_full && n > 1) {
+        var = var * (float)(PARTIAL_VAR_NUM(n)) / (float)(PARTIAL_VAR_DEN(n));
+    }
+    return feat_std(var, n);
+}
+
+static float calc_range(const WindowBuffer *win, int ch) {
+    const int16_t *data = win->samples[ch];
+    return feat_range(data[deque_front(&win->max_q[ch])], data[deque_front(&win->min_q[ch])]);
+}
+#endif
+
+// Versões inteiras (Q8)
+static int32_t calc_std_q(const WindowBuffer *win, int ch) {
+    int64_t n = win->count;
+    uint64_t var_n2 = (uint64_t)feat_var_n2(n, win->sum[ch], win->sum_sq[ch]);
+    uint64_t x = var_n2 << (2 * FEATURE_Q_FRAC_BITS);
+    if (!win->is_full && n > 1) {
+        // x * num / den sem estourar: o resultado cabe porque n < WINDOW_SIZE
+        uint64_t num = PARTIAL_VAR_NUM(n), den = PARTIAL_VAR_DEN(n);
+        x = x / den * num + x % den * num / den;
     }
-    return crossings / 2.0f;
+    return feat_std_q(x, n);
+}
+
+static int32_t calc_range_q(const WindowBuffer *win, int ch) {
+    const int16_t *data = win->samples[ch];
+    return feat_range_q(data[deque_front(&win->max_q[ch])], data[deque_front(&win->min_q[ch])]);
+}
+
+// Passos de sinal (feat_sign_steps) pela janela em ordem cronológica: cheia,
+// de index ao fim do anel e depois do início até index
+static int calc_sign_steps(const WindowBuffer *win, int ch) {
+    const int16_t *data = win->samples[ch];
+    int32_t n = win->count;
+    int32_t s = win->sum[ch];
+    int start = win->is_full ? win->index : 0;
+    int prev = feat_sign(data[start], n, s);
+    int steps = feat_sign_steps(data + start, 1, n - start, n, s, &prev);
+    return steps + feat_sign_steps(data, 1, start, n, s, &prev);
+}
+
+// ZCR (passos / 2) em Q8; na janela parcial, estendido para os
+// WINDOW_SIZE - 1 pares de amostras da janela cheia
+static int32_t calc_zcr_q(const WindowBuffer *win, int ch) {
+    int32_t c = feat_zcr_q(calc_sign_steps(win, ch));
+    int32_t pairs = win->count - 1;
+    if (win->is_full || pairs < 1) return c;
+    return (c * (WINDOW_SIZE - 1) + pairs / 2) / pairs;
+}
+
+#if !FEATURES_FIXED_POINT
+static float calc_zcr(const WindowBuffer *win, int ch) {
+    float z = feat_zcr(calc_sign_steps(win, ch));
+    if (!win->is_full && win->count > 1) z = z * (WINDOW_SIZE - 1) / (win->count - 1);
+    return z;
 }
+#endif
 
 // Implementação da Janela
 void window_init(WindowBuffer *win) {
-    win->index = 0;
-    win->is_full = false;
-    memset(win->ax, 0, sizeof(win->ax)); // Limpa memória
+    memset(win, 0, sizeof(*win)); // Limpa memória e estado incremental
 }
 
 void window_add_sample(WindowBuffer *win, int16_t *accel, int16_t *gyro) {
-    win->ax[win->index] = accel[0];
-    win->ay[win->index] = accel[1];
-    win->az[win->index] = accel[2];
-    win->gx[win->index] = gyro[0];
-    win->gy[win->index] = gyro[1];
-    win->gz[win->index] = gyro[2];
+    int slot = win->index;
+    int16_t in[WINDOW_CHANNELS] = { accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2] };
 
+    // Remove a amostra mais antiga do estado
+    if (win->is_full) {
+        for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+            int32_t old = win->samples[ch][slot];
+            win->sum[ch] -= old;
+            win->sum_sq[ch] -= old * old;
+        }
+        win->sum_mag_a -= win->mag_a[slot];
+        win->sum_mag_g -= win->mag_g[slot];
+        for (int ch = 0; ch < RANGE_CHANNELS; ch++) {
+            deque_evict(&win->min_q[ch], slot);
+            deque_evict(&win->max_q[ch], slot);
+        }
+    }
+
+    // Insere a nova
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        int32_t v = in[ch];
+        win->samples[ch][slot] = in[ch];
+        win->sum[ch] += v;
+        win->sum_sq[ch] += v * v;
+    }
+    win->mag_a[slot] = feat_mag_q8(in[CH_AX], in[CH_AY], in[CH_AZ]);
+    win->mag_g[slot] = feat_mag_q8(in[CH_GX], in[CH_GY], in[CH_GZ]);
+    win->sum_mag_a += win->mag_a[slot];
+    win->sum_mag_g += win->mag_g[slot];
+    for (int ch = 0; ch < RANGE_CHANNELS; ch++) {
+        deque_push(&win->min_q[ch], win->samples[ch], slot, false);
+        deque_push(&win->max_q[ch], win->samples[ch], slot, true);
+    }
+
+    if (win->count < WINDOW_SIZE) win->count++;
     win->index++;
     if (win->index >= WINDOW_SIZE) {
         win->index = 0;
@@ -65,29 +152,65 @@ bool window_is_ready(WindowBuffer *win) {
     return win->is_full;
 }
 
+void extract_features_q(WindowBuffer *win, int32_t *f) {
+    const uint32_t n = (uint32_t)win->count;
+
+    //Desvio Padrão
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        f[ch] = calc_std_q(win, ch);
+    }
+
+    //Magnitude Média (Q8 -> Q8)
+    f[6] = feat_mean_mag_q(win->sum_mag_a, n);
+    f[7] = feat_mean_mag_q(win->sum_mag_g, n);
+
+    //Range e ZCR (cruzamentos pela média em Q8)
+    for (int ch = 0; ch < RANGE_CHANNELS; ch++) {
+        f[8 + ch] = calc_range_q(win, ch);
+        f[11 + ch] = calc_zcr_q(win, ch);
+    }
+}
+
+void extract_features_int8(WindowBuffer *win, const FeatureQuant *quant, int8_t *out) {
+    int32_t q[NUM_FEATURES];
+    extract_features_q(win, q);
+    features_quantize_int8(q, quant, out);
+}
+
+void features_quantize_int8(const int32_t *q, const FeatureQuant *quant, int8_t *out) {
+    for (int i = 0; i < NUM_FEATURES; i++) {
+        int64_t v = ((int64_t)q[i] * quant[i].mult + quant[i].offset) >> quant[i].shift;
+        if (v < -128) v = -128;
+        if (v > 127) v = 127;
+        out[i] = (int8_t)v;
+    }
+}
+
+#if FEATURES_FIXED_POINT
+void extract_features(WindowBuffer *win, float *f) {
+    int32_t q[NUM_FEATURES];
+    extract_features_q(win, q);
+    for (int i = 0; i < NUM_FEATURES; i++) {
+        f[i] = (float)q[i] * (1.0f / (1 << FEATURE_Q_FRAC_BITS));
+    }
+}
+#else
 void extract_features(WindowBuffer *win, float *f) {
     //Desvio Padrão
-    f[0] = calc_std(win->ax, WINDOW_SIZE);
-    f[1] = calc_std(win->ay, WINDOW_SIZE);
-    f[2] = calc_std(win->az, WINDOW_SIZE);
-    f[3] = calc_std(win->gx, WINDOW_SIZE);
-    f[4] = calc_std(win->gy, WINDOW_SIZE);
-    f[5] = calc_std(win->gz, WINDOW_SIZE);
+    for (int ch = 0; ch < WINDOW_CHANNELS; ch++) {
+        f[ch] = calc_std(win, ch);
+    }
 
     //Magnitude Média
-    float sum_mag_a = 0, sum_mag_g = 0;
-    for(int i=0; i<WINDOW_SIZE; i++) {
-        sum_mag_a += sqrtf(win->ax[i]*win->ax[i] + win->ay[i]*win->ay[i] + win->az[i]*win->az[i]);
-        sum_mag_g += sqrtf(win->gx[i]*win->gx[i] + win->gy[i]*win->gy[i] + win->gz[i]*win->gz[i]);
-    }
-    f[6] = sum_mag_a / WINDOW_SIZE;
-    f[7] = sum_mag_g / WINDOW_SIZE;
+    f[6] = feat_mean_mag(win->sum_mag_a, win->count);
+    f[7] = feat_mean_mag(win->sum_mag_g, win->count);
 
     //Range e ZCR
-    f[8] = calc_range(win->ax, WINDOW_SIZE);
-    f[9] = calc_range(win->ay, WINDOW_SIZE);
-    f[10] = calc_range(win->az, WINDOW_SIZE);
-    f[11] = calc_zcr(win->ax, WINDOW_SIZE);
-    f[12] = calc_zcr(win->ay, WINDOW_SIZE);
-    f[13] = calc_zcr(win->az, WINDOW_SIZE);
-}
\ No newline at end of file
+    f[8] = calc_range(win, CH_AX);
+    f[9] = calc_range(win, CH_AY);
+    f[10] = calc_range(win, CH_AZ);
+    f[11] = calc_zcr(win, CH_AX);
+    f[12] = calc_zcr(win, CH_AY);
+    f[13] = calc_zcr(win, CH_AZ);
+}
+#endif
@@ -0,0 +1,162 @@
+#include "include/hal.h"
+#include "include/mpu6500.h"
+#include "config.h"
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#if PIPELINE_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+
+void hal_init(void) {
+    stdio_init_all();
+
+    /* ---------- Inicialização dos LEDs ---------- */
+    gpio_init(LED_R);
+    gpio_set_dir(LED_R, GPIO_OUT);
+
+    gpio_init(LED_G);
+    gpio_set_dir(LED_G, GPIO_OUT);
+
+    gpio_init(LED_B);
+    gpio_set_dir(LED_B, GPIO_OUT);
+
+    /* ---------- Inicialização I2C ---------- */
+    i2c_init(I2C_PORT, 400 * 1000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+
+    /* ---------- SysTick livre para hal_cycles ---------- */
+    systick_hw->csr = 0;
+    systick_hw->rvr = HAL_CYCLES_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;   // ENABLE | CLKSOURCE (clk_sys), sem interrupção
+}
+
+void hal_imu_init(void) {
+    mpu6500_init();
+#if MPU6500_USE_FIFO
+    mpu6500_fifo_init(MPU6500_SAMPLE_RATE_DIV);
+#endif
+}
+
+bool hal_running(void) {
+    return true;
+}
+
+uint32_t hal_millis(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+uint32_t hal_micros(void) {
+    return time_us_32();
+}
+
+void hal_sleep_ms(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void hal_sleep_us(uint32_t us) {
+    sleep_us(us);
+}
+
+/* ---------- Timer de amostragem ---------- */
+static repeating_timer_t sample_timer;
+static volatile uint32_t timer_ticks;
+static uint32_t timer_missed;
+
+static bool on_sample_timer(repeating_timer_t *rt) {
+    (void)rt;
+    timer_ticks++;
+    return true;
+}
+
+uint32_t hal_timer_start(uint32_t period_us) {
+    timer_ticks = 0;
+    timer_missed = 0;
+    uint32_t first_due = time_us_32() + period_us;
+    // Período negativo: intervalo medido entre inícios de callback (sem deriva)
+    add_repeating_timer_us(-(int64_t)period_us, on_sample_timer, NULL, &sample_timer);
+    return first_due;
+}
+
+uint32_t hal_timer_wait(void) {
+    // Testa e dorme com as interrupções mascaradas: um alarme entre o teste e
+    // o WFI fica pendente e acorda o core (o WFI acorda com PRIMASK ligado),
+    // em vez de esperar a próxima interrupção qualquer
+    uint32_t irq = save_and_disable_interrupts();
+    while (timer_ticks == 0) {
+        __wfi();
+        restore_interrupts(irq);
+        irq = save_and_disable_interrupts();
+    }
+    timer_missed += timer_ticks - 1;
+    timer_ticks = 0;
+    restore_interrupts(irq);
+
+    return time_us_32();
+}
+
+uint32_t hal_timer_missed(void) {
+    return timer_missed;
+}
+
+/* ---------- Ciclos e console ---------- */
+
+// SysTick conta para baixo; invertido vira um contador crescente de 24 bits
+uint32_t hal_cycles(void) {
+    return HAL_CYCLES_MASK - systick_hw->cvr;
+}
+
+uint32_t hal_cycles_per_us(void) {
+    return clock_get_hz(clk_sys) / 1000000;
+}
+
+int hal_console_getchar(void) {
+    int c = getchar_timeout_us(0);
+    return c < 0 ? -1 : c;
+}
+
+void hal_read_imu(int16_t *accel, int16_t *gyro) {
+    mpu6500_read_data(accel, gyro);
+}
+
+int hal_read_imu_batch(int16_t (*accel)[3], int16_t (*gyro)[3], int max_samples) {
+    int n = mpu6500_fifo_read(accel, gyro, max_samples);
+    return n < 0 ? 0 : n; // overflow: FIFO já foi zerado pelo driver
+}
+
+int hal_imu_pending(void) {
+    return mpu6500_fifo_stats()->pending;
+}
+
+int hal_i2c_write(uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    return i2c_write_blocking(I2C_PORT, addr, src, len, nostop);
+}
+
+int hal_i2c_read(uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    return i2c_read_blocking(I2C_PORT, addr, dst, len, nostop);
+}
+
+void hal_led_put(uint32_t pin, bool on) {
+    gpio_put(pin, on);
+}
+
+#if PIPELINE_DUAL_CORE
+void hal_launch_core1(void (*entry)(void)) {
+    multicore_launch_core1(entry);
+}
+
+// SEV/WFE: o evento fica registrado se o sinal vier antes da espera
+void hal_core_signal(void) {
+    __sev();
+}
+
+void hal_core_wait(void) {
+    __wfe();
+}
+#endif
@@ -0,0 +1,48 @@
+#include "include/jitter.h"
+#include <stdio.h>
+#include <string.h>
+
+void jitter_init(JitterStats *j, uint32_t period_us, uint32_t first_due_us) {
+    memset(j, 0, sizeof(*j));
+    j->period_us = period_us;
+    j->next_due_us = first_due_us;
+}
+
+int jitter_bin(uint32_t late_us) {
+    if (late_us == 0) return 0;
+    int bin = 32 - __builtin_clz(late_us);
+    return bin < JITTER_BINS ? bin : JITTER_BINS - 1;
+}
+
+void jitter_record(JitterStats *j, uint32_t t_us) {
+    int32_t diff = (int32_t)(t_us - j->next_due_us);
+    uint32_t late = diff > 0 ? (uint32_t)diff : 0;
+
+    // Atrasou períodos inteiros: amostras perdidas, realinha na grade
+    if (late >= j->period_us) {
+        uint32_t skipped = late / j->period_us;
+        j->missed += skipped;
+        j->next_due_us += skipped * j->period_us;
+        late -= skipped * j->period_us;
+    }
+
+    j->hist[jitter_bin(late)]++;
+    if (late > j->max_late_us) j->max_late_us = late;
+    j->sum_late_us += late;
+    j->samples++;
+    j->last_us = t_us;
+    j->next_due_us += j->period_us;
+}
+
+void jitter_print(const JitterStats *j) {
+    printf("Jitter: %lu amostras | perdidas %lu | medio %lu us | max %lu us\n",
+           (unsigned long)j->samples, (unsigned long)j->missed,
+           (unsigned long)(j->samples ? j->sum_late_us / j->samples : 0),
+           (unsigned long)j->max_late_us);
+
+    for (int b = 0; b < JITTER_BINS; b++) {
+        if (j->hist[b] == 0) continue;
+        uint32_t lo = b == 0 ? 0 : 1u << (b - 1);
+        printf("  >= %6lu us: %lu\n", (unsigned long)lo, (unsigned long)j->hist[b]);
+    }
+}
@@ -0,0 +1,28 @@
+#include "include/motion_gate.h"
+#include <stddef.h>
+
+void motion_gate_init(MotionGate *g, const MotionGateThresholds *th) {
+    if (th != NULL) {
+        g->th = *th;
+    } else {
+        g->th.accel_std_q8 = MOTION_GATE_ACCEL_STD_Q8;
+        g->th.gyro_std_q8 = MOTION_GATE_GYRO_STD_Q8;
+    }
+    g->windows = 0;
+    g->still = 0;
+}
+
+void motion_gate_stats(const int32_t *f, int32_t *accel_std_q8, int32_t *gyro_std_q8) {
+    *accel_std_q8 = f[CH_AX] + f[CH_AY] + f[CH_AZ];
+    *gyro_std_q8 = f[CH_GX] + f[CH_GY] + f[CH_GZ];
+}
+
+bool motion_gate_is_still(MotionGate *g, const int32_t *features_q) {
+    int32_t accel, gyro;
+    motion_gate_stats(features_q, &accel, &gyro);
+    g->windows++;
+
+    if (accel > g->th.accel_std_q8 || gyro > g->th.gyro_std_q8) return false;
+    g->still++;
+    return true;
+}
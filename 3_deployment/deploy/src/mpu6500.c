@@ -1,34 +1,121 @@
 #include "include/mpu6500.h"
+#include "include/hal.h"
 #include "config.h"
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
 
-#define PWR_MGMT_1 0x6B
+#define SMPLRT_DIV 0x19
+#define CONFIG 0x1A
+#define FIFO_EN 0x23
+#define INT_ENABLE 0x38
+#define INT_STATUS 0x3A
 #define ACCEL_XOUT_H 0x3B
+#define USER_CTRL 0x6A
+#define PWR_MGMT_1 0x6B
+#define FIFO_COUNTH 0x72
+#define FIFO_R_W 0x74
+
+#define CONFIG_FIFO_MODE 0x40     // FIFO cheio não sobrescreve (sinaliza overflow)
+#define CONFIG_DLPF_184HZ 0x01    // taxa interna de 1 kHz
+#define FIFO_EN_GYRO_ACCEL 0x78   // GX, GY, GZ e ACCEL
+#define INT_FIFO_OFLOW 0x10
+#define USER_CTRL_FIFO_EN 0x40
+#define USER_CTRL_FIFO_RST 0x04
+
+// Maior rajada lida de uma vez
+#define FIFO_MAX_BURST (MPU6500_FIFO_SIZE / MPU6500_FIFO_FRAME)
 
-// Função auxiliar interna 
+static Mpu6500FifoStats fifo_stats;
+
+// Funções auxiliares internas
 static void mpu_write(uint8_t reg, uint8_t data) {
     uint8_t buf[2] = {reg, data};
-    i2c_write_blocking(I2C_PORT, MPU6500_ADDR, buf, 2, false);
+    hal_i2c_write(MPU6500_ADDR, buf, 2, false);
+}
+
+static void mpu_read(uint8_t reg, uint8_t *buffer, uint16_t len) {
+    hal_i2c_write(MPU6500_ADDR, &reg, 1, true);
+    hal_i2c_read(MPU6500_ADDR, buffer, len, false);
+}
+
+static inline int16_t be16(const uint8_t *p) {
+    return (int16_t)((p[0] << 8) | p[1]);
 }
 
 void mpu6500_init(void) {
     mpu_write(PWR_MGMT_1, 0x00); // Acorda o sensor
-    sleep_ms(100);
+    hal_sleep_ms(100);
 }
 
 void mpu6500_read_data(int16_t *accel, int16_t *gyro) {
-    uint8_t reg = ACCEL_XOUT_H;
     uint8_t buffer[14];
-    
-    i2c_write_blocking(I2C_PORT, MPU6500_ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, MPU6500_ADDR, buffer, 14, false);
-    
-    accel[0] = (buffer[0] << 8) | buffer[1];
-    accel[1] = (buffer[2] << 8) | buffer[3];
-    accel[2] = (buffer[4] << 8) | buffer[5];
-    
-    gyro[0] = (buffer[8] << 8) | buffer[9];
-    gyro[1] = (buffer[10] << 8) | buffer[11];
-    gyro[2] = (buffer[12] << 8) | buffer[13];
-}
\ No newline at end of file
+
+    mpu_read(ACCEL_XOUT_H, buffer, 14);
+
+    accel[0] = be16(&buffer[0]);
+    accel[1] = be16(&buffer[2]);
+    accel[2] = be16(&buffer[4]);
+
+    gyro[0] = be16(&buffer[8]);
+    gyro[1] = be16(&buffer[10]);
+    gyro[2] = be16(&buffer[12]);
+}
+
+void mpu6500_fifo_init(uint8_t sample_rate_div) {
+    mpu_write(CONFIG, CONFIG_FIFO_MODE | CONFIG_DLPF_184HZ);
+    mpu_write(SMPLRT_DIV, sample_rate_div);
+    mpu_write(INT_ENABLE, INT_FIFO_OFLOW);
+    mpu_write(FIFO_EN, FIFO_EN_GYRO_ACCEL);
+    mpu6500_fifo_reset();
+}
+
+void mpu6500_fifo_reset(void) {
+    uint8_t status;
+    mpu_write(USER_CTRL, USER_CTRL_FIFO_RST);
+    mpu_write(USER_CTRL, USER_CTRL_FIFO_EN);
+    mpu_read(INT_STATUS, &status, 1); // limpa overflow antigo
+}
+
+uint16_t mpu6500_fifo_count(void) {
+    uint8_t buf[2];
+    mpu_read(FIFO_COUNTH, buf, 2);
+    return (uint16_t)(((buf[0] & 0x1F) << 8) | buf[1]);
+}
+
+int mpu6500_fifo_read(int16_t (*accel)[3], int16_t (*gyro)[3], int max_samples) {
+    static uint8_t burst[FIFO_MAX_BURST * MPU6500_FIFO_FRAME];
+    uint8_t status;
+
+    mpu_read(INT_STATUS, &status, 1);
+    if (status & INT_FIFO_OFLOW) {
+        fifo_stats.overflows++;
+        fifo_stats.pending = 0;
+        mpu6500_fifo_reset();
+        return MPU6500_FIFO_OVERFLOW;
+    }
+
+    int available = mpu6500_fifo_count() / MPU6500_FIFO_FRAME;
+    int n = available;
+    if (n > max_samples) n = max_samples;
+    if (n > FIFO_MAX_BURST) n = FIFO_MAX_BURST;
+    fifo_stats.pending = (uint16_t)(available - n);
+    if (n == 0) return 0;
+
+    // Uma única transação para todas as amostras completas
+    mpu_read(FIFO_R_W, burst, (uint16_t)(n * MPU6500_FIFO_FRAME));
+    fifo_stats.transactions++;
+    fifo_stats.samples += n;
+
+    for (int i = 0; i < n; i++) {
+        const uint8_t *f = &burst[i * MPU6500_FIFO_FRAME];
+        accel[i][0] = be16(&f[0]);
+        accel[i][1] = be16(&f[2]);
+        accel[i][2] = be16(&f[4]);
+        gyro[i][0] = be16(&f[6]);
+        gyro[i][1] = be16(&f[8]);
+        gyro[i][2] = be16(&f[10]);
+    }
+    return n;
+}
+
+const Mpu6500FifoStats* mpu6500_fifo_stats(void) {
+    return &fifo_stats;
+}
@@ -0,0 +1,49 @@
+#include "include/pipeline.h"
+#include <string.h>
+
+void pipeline_init(Pipeline *p, uint32_t period_us, uint32_t now_us) {
+    memset(p, 0, sizeof(*p));
+    ring_init(&p->ring);
+    p->period_us = period_us;
+    p->next_due_us = now_us;
+}
+
+uint32_t pipeline_time_to_next(Pipeline *p, uint32_t now_us) {
+    int32_t slack = (int32_t)(p->next_due_us - now_us);
+    if (slack > 0) return (uint32_t)slack;
+
+    // Perdeu um período inteiro: conta e reagenda a partir de agora
+    if ((uint32_t)(-slack) >= p->period_us) {
+        __atomic_store_n(&p->overruns, p->overruns + 1, __ATOMIC_RELAXED);
+        p->next_due_us = now_us;
+    }
+    return 0;
+}
+
+void pipeline_produce(Pipeline *p, uint32_t t_us, const int16_t *accel, const int16_t *gyro) {
+    TimedSample s;
+    s.seq = p->seq++;
+    s.t_us = t_us;
+    memcpy(s.accel, accel, sizeof(s.accel));
+    memcpy(s.gyro, gyro, sizeof(s.gyro));
+
+    if (!ring_push(&p->ring, &s)) __atomic_store_n(&p->dropped, p->dropped + 1, __ATOMIC_RELAXED);
+    p->next_due_us += p->period_us;
+}
+
+bool pipeline_consume(Pipeline *p, TimedSample *out) {
+    if (!ring_pop(&p->ring, out)) return false;
+
+    __atomic_store_n(&p->gaps, p->gaps + (out->seq - p->expected_seq), __ATOMIC_RELAXED);
+    p->expected_seq = out->seq + 1;
+    p->consumed++;
+    return true;
+}
+
+PipelineStats pipeline_stats(const Pipeline *p) {
+    PipelineStats st;
+    st.overruns = __atomic_load_n(&p->overruns, __ATOMIC_RELAXED);
+    st.dropped = __atomic_load_n(&p->dropped, __ATOMIC_RELAXED);
+    st.gaps = __atomic_load_n(&p->gaps, __ATOMIC_RELAXED);
+    return st;
+}
@@ -0,0 +1,115 @@
+#include "include/profiler.h"
+
+#if PROFILER_ENABLE
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t start;
+    uint32_t count;
+    uint32_t min, max;
+    uint64_t total;
+    uint32_t hist[PROFILER_BINS];
+} ProfStage;
+
+static const char *stage_names[PROF_STAGE_COUNT] = {
+    "processo", "sensor", "decimate", "window", "features", "inference", "output", "spectral"
+};
+
+static ProfStage stages[PROF_STAGE_COUNT];
+
+/* ---------- Histograma logarítmico ---------- */
+
+// 0..3 exatos; acima, 4 faixas por oitava: [4..7] [8,10,12,14] [16,20,24,28]...
+int profiler_bin(uint32_t cycles) {
+    if (cycles < 4) return (int)cycles;
+    int octave = 31 - __builtin_clz(cycles);
+    int bin = (octave - 1) * 4 + (int)((cycles >> (octave - 2)) & 3);
+    return bin < PROFILER_BINS ? bin : PROFILER_BINS - 1;
+}
+
+uint32_t profiler_bin_floor(int bin) {
+    if (bin < 4) return (uint32_t)bin;
+    int octave = bin / 4 + 1;
+    return (uint32_t)(4 + bin % 4) << (octave - 2);
+}
+
+// Meio da faixa do histograma, limitado pelo mín/máx exatos (p0 e p100
+// são o próprio mín/máx)
+uint32_t profiler_percentile(prof_stage_t stage, uint32_t permille) {
+    const ProfStage *s = &stages[stage];
+    if (s->count == 0) return 0;
+    if (permille == 0) return s->min;
+    if (permille >= 1000) return s->max;
+
+    uint64_t rank = ((uint64_t)s->count * permille + 999) / 1000;
+    uint64_t seen = 0;
+    for (int b = 0; b < PROFILER_BINS; b++) {
+        seen += s->hist[b];
+        if (seen < rank) continue;
+        uint32_t lo = profiler_bin_floor(b);
+        uint32_t hi = b + 1 < PROFILER_BINS ? profiler_bin_floor(b + 1) - 1 : HAL_CYCLES_MASK;
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (mid < s->min) mid = s->min;
+        if (mid > s->max) mid = s->max;
+        return mid;
+    }
+    return s->max;
+}
+
+uint32_t profiler_count(prof_stage_t stage) {
+    return stages[stage].count;
+}
+
+/* ---------- Medição ---------- */
+
+void profiler_init(void) {
+    profiler_reset();
+}
+
+void profiler_reset(void) {
+    memset(stages, 0, sizeof(stages));
+}
+
+void prof_begin(prof_stage_t stage) {
+    stages[stage].start = hal_cycles();
+}
+
+void prof_end(prof_stage_t stage) {
+    ProfStage *s = &stages[stage];
+    uint32_t dt = (hal_cycles() - s->start) & HAL_CYCLES_MASK;
+
+    if (s->count == 0 || dt < s->min) s->min = dt;
+    if (dt > s->max) s->max = dt;
+    s->total += dt;
+    s->count++;
+    s->hist[profiler_bin(dt)]++;
+}
+
+/* ---------- Console ---------- */
+
+void profiler_dump(void) {
+    float per_us = (float)hal_cycles_per_us();
+    printf("Perfil (us, p50/p99 com ~20%% de resolucao):\n");
+    printf("%-10s %9s %9s %9s %9s %9s %9s\n", "estagio", "chamadas", "min", "p50", "p99", "max", "media");
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        const ProfStage *s = &stages[i];
+        if (s->count == 0) continue;
+        printf("%-10s %9lu %9.1f %9.1f %9.1f %9.1f %9.1f\n", stage_names[i], (unsigned long)s->count,
+               s->min / per_us, profiler_percentile((prof_stage_t)i, 500) / per_us,
+               profiler_percentile((prof_stage_t)i, 990) / per_us, s->max / per_us,
+               (float)s->total / s->count / per_us);
+    }
+}
+
+void profiler_poll(void) {
+    int c = hal_console_getchar();
+    if (c == 'p') {
+        profiler_dump();
+    } else if (c == 'r') {
+        profiler_reset();
+        printf("Perfil zerado\n");
+    }
+}
+
+#endif
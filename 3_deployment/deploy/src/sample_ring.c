@@ -0,0 +1,34 @@
+#include "include/sample_ring.h"
+
+#define RING_MASK (SAMPLE_RING_SIZE - 1)
+
+void ring_init(SampleRing *ring) {
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+bool ring_push(SampleRing *ring, const TimedSample *sample) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail >= SAMPLE_RING_SIZE) return false;
+
+    ring->buf[head & RING_MASK] = *sample;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool ring_pop(SampleRing *ring, TimedSample *sample) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) return false;
+
+    *sample = ring->buf[tail & RING_MASK];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t ring_count(const SampleRing *ring) {
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,258 @@
+#include "include/spectral.h"
+#include "include/fixed_math.h"
+#include "config.h"
+#include <string.h>
+
+namespace {
+
+constexpr int N = SPECTRAL_FFT_SIZE;
+constexpr int M = N / 2;   // pontos da FFT complexa
+
+constexpr int log2_int(int n) {
+    int r = 0;
+    while ((1 << r) < n) r++;
+    return r;
+}
+constexpr int LOG2_N = log2_int(N);
+
+// Amplitude máxima do sinal normalizado: a FFT cresce até N vezes e a saída
+// dobrada (X2 = 2X) fica abaixo de 2^29; pela identidade de Parseval a soma
+// das potências fica abaixo de 2^58
+constexpr int INPUT_BITS = 28 - LOG2_N;
+static_assert(N >= 8 && (N & (N - 1)) == 0 && INPUT_BITS >= 18,
+              "SPECTRAL_FFT_SIZE deve ser potencia de 2 entre 8 e 1024");
+
+/* ---------- Tabelas em tempo de compilação ---------- */
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Série de Taylor depois de reduzir a [-pi, pi]; 20 termos sobram para Q15
+constexpr double cx_sin(double x) {
+    while (x > kPi) x -= 2 * kPi;
+    while (x < -kPi) x += 2 * kPi;
+    double term = x, sum = x;
+    for (int i = 1; i < 20; i++) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cx_cos(double x) {
+    return cx_sin(x + kPi / 2);
+}
+
+constexpr int32_t to_q15(double v) {
+    return (int32_t)(v * 32768.0 + (v >= 0 ? 0.5 : -0.5));
+}
+
+struct Tables {
+    int32_t cos[M + 1];   // cos(2 pi k / N), Q15 (32768 = 1)
+    int32_t sin[M + 1];
+    int32_t hann[N];      // Hann periódica, Q15
+    uint16_t bitrev[M];
+    uint16_t band_start[SPECTRAL_BANDS + 1];   // primeiro bin de cada banda; o último é M + 1
+};
+
+constexpr Tables make_tables() {
+    Tables t = {};
+    for (int k = 0; k <= M; k++) {
+        t.cos[k] = to_q15(cx_cos(2 * kPi * k / N));
+        t.sin[k] = to_q15(cx_sin(2 * kPi * k / N));
+    }
+    for (int n = 0; n < N; n++) {
+        t.hann[n] = to_q15(0.5 * (1.0 - cx_cos(2 * kPi * n / N)));
+    }
+    for (int i = 0; i < M; i++) {
+        int r = 0;
+        for (int b = 0; b < LOG2_N - 1; b++) {
+            if (i & (1 << b)) r |= 1 << (LOG2_N - 2 - b);
+        }
+        t.bitrev[i] = (uint16_t)r;
+    }
+
+    // Bin k está em k * fs / N Hz; a banda b começa no primeiro bin >= borda
+    const int edges_dhz[SPECTRAL_BANDS] = SPECTRAL_BAND_EDGES_DHZ;
+    const long fs_mhz = 1000000L / SAMPLE_INTERVAL_MS;
+    for (int b = 0; b < SPECTRAL_BANDS; b++) {
+        long k = ((long)edges_dhz[b] * 100 * N + fs_mhz - 1) / fs_mhz;
+        if (k < 1) k = 1;
+        if (k > M) k = M;
+        t.band_start[b] = (uint16_t)k;
+    }
+    t.band_start[SPECTRAL_BANDS] = M + 1;
+    return t;
+}
+
+constexpr Tables kTab = make_tables();
+static_assert(kTab.cos[0] == 32768 && kTab.sin[M / 2] == 32768 && kTab.cos[M] == -32768,
+              "tabelas de twiddle");
+
+constexpr long kSampleRateMhz = 1000000L / SAMPLE_INTERVAL_MS;
+
+/* ---------- FFT ---------- */
+
+static inline int32_t mul_q15(int64_t a, int64_t b) {
+    return (int32_t)((a * b + (1 << 14)) >> 15);
+}
+
+// FFT complexa radix-2 de M pontos no lugar (decimação no tempo)
+static void fft_complex(int32_t *re, int32_t *im) {
+    for (int i = 0; i < M; i++) {
+        int j = kTab.bitrev[i];
+        if (i < j) {
+            int32_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for (int len = 2; len <= M; len <<= 1) {
+        const int half = len / 2, step = N / len;   // W_len^j = W_N^(j * N / len)
+        for (int i = 0; i < M; i += len) {
+            for (int j = 0; j < half; j++) {
+                int64_t wr = kTab.cos[j * step], wi = -kTab.sin[j * step];
+                int a = i + j, b = a + half;
+                int32_t tr = (int32_t)((re[b] * wr - im[b] * wi + (1 << 14)) >> 15);
+                int32_t ti = (int32_t)((re[b] * wi + im[b] * wr + (1 << 14)) >> 15);
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+static int msb64(uint64_t x) {
+    return 63 - __builtin_clzll(x);
+}
+
+} // namespace
+
+extern "C" void spectral_init(SpectralWindow *sw) {
+    memset(sw, 0, sizeof(*sw));
+}
+
+extern "C" void spectral_push(SpectralWindow *sw, uint32_t mag_q8) {
+    sw->mag[sw->index] = mag_q8;
+    if (++sw->index == N) sw->index = 0;
+    if (sw->count < N) sw->count++;
+}
+
+extern "C" void spectral_add_sample(SpectralWindow *sw, const WindowBuffer *win) {
+    spectral_push(sw, win->mag_a[(win->index + WINDOW_SIZE - 1) % WINDOW_SIZE]);
+}
+
+extern "C" bool spectral_is_ready(const SpectralWindow *sw) {
+    return sw->count == N;
+}
+
+extern "C" int spectral_power(SpectralWindow *sw, uint64_t *power) {
+    memset(power, 0, SPECTRAL_BINS * sizeof(uint64_t));
+    if (!spectral_is_ready(sw)) return 0;
+
+    // Ordem cronológica (a mais antiga está em index), sem a média; os pares
+    // de amostras reais já vão para re/im do sinal complexo de M pontos
+    uint64_t sum = 0;
+    for (int n = 0; n < N; n++) sum += sw->mag[n];
+    const int64_t mean = (int64_t)((sum + N / 2) >> LOG2_N);
+
+    int32_t *re = sw->re, *im = sw->im;
+    uint32_t peak = 0;
+    for (int n = 0, pos = sw->index; n < N; n++, pos = (pos + 1) & (N - 1)) {
+        int32_t y = mul_q15((int64_t)sw->mag[pos] - mean, kTab.hann[n]);
+        (n & 1 ? im : re)[n >> 1] = y;
+        uint32_t a = (uint32_t)(y < 0 ? -y : y);
+        if (a > peak) peak = a;
+    }
+    if (peak == 0) return 0;
+
+    // Bloco em ponto flutuante: maior amplitude logo abaixo de 2^INPUT_BITS
+    const int shift = INPUT_BITS - 1 - msb64(peak);
+    for (int k = 0; k < M; k++) {
+        int64_t e = re[k], o = im[k];
+        if (shift >= 0) {
+            re[k] = (int32_t)(e << shift);
+            im[k] = (int32_t)(o << shift);
+        } else {
+            re[k] = (int32_t)((e + (1ll << (-shift - 1))) >> -shift);
+            im[k] = (int32_t)((o + (1ll << (-shift - 1))) >> -shift);
+        }
+    }
+    fft_complex(re, im);
+
+    // Separação: 2X[k] = (Z[k] + Z*[M-k]) - i W_N^k (Z[k] - Z*[M-k])
+    for (int k = 0; k <= M; k++) {
+        int a = k % M, b = (M - k) % M;
+        int64_t fe_r = (int64_t)re[a] + re[b], fe_i = (int64_t)im[a] - im[b];
+        int64_t d_r = (int64_t)re[a] - re[b], d_i = (int64_t)im[a] + im[b];
+        int64_t fo_r = d_i, fo_i = -d_r;
+        int64_t wr = kTab.cos[k], wi = -kTab.sin[k];
+        int64_t x_r = fe_r + mul_q15(fo_r, wr) - mul_q15(fo_i, wi);
+        int64_t x_i = fe_i + mul_q15(fo_r, wi) + mul_q15(fo_i, wr);
+        power[k] = (uint64_t)(x_r * x_r) + (uint64_t)(x_i * x_i);
+    }
+    return shift;
+}
+
+extern "C" void spectral_extract_q(SpectralWindow *sw, int32_t *f) {
+    memset(f, 0, SPECTRAL_NUM_FEATURES * sizeof(int32_t));
+
+    uint64_t *power = sw->power;
+    spectral_power(sw, power);
+
+    const int lo = kTab.band_start[0];
+    uint64_t total = 0;
+    for (int k = lo; k <= M; k++) total += power[k];
+    if (total == 0) return;
+
+    // Potências abaixo de 2^32 para os produtos com log2 caberem em 64 bits
+    const int down = msb64(total) > 31 ? msb64(total) - 31 : 0;
+    uint64_t *p = power;
+    for (int k = 0; k <= M; k++) p[k] >>= down;
+
+    uint64_t t = 0, sum_plog = 0;
+    int peak = lo;
+    for (int k = lo; k <= M; k++) {
+        t += p[k];
+        sum_plog += (uint64_t)p[k] * ilog2_q16(p[k]);
+        if (p[k] > p[peak]) peak = k;
+    }
+    if (t == 0) return;
+
+    // Frequência dominante: vértice da parábola pelos três bins do pico
+    int32_t delta_q8 = 0;
+    if (peak > 0 && peak < M) {
+        int64_t a = p[peak - 1], b = p[peak], c = p[peak + 1];
+        int64_t den = a - 2 * b + c;
+        if (den != 0) delta_q8 = (int32_t)((a - c) * 128 / den);
+        if (delta_q8 > 128) delta_q8 = 128;
+        if (delta_q8 < -128) delta_q8 = -128;
+    }
+    f[0] = (int32_t)(((int64_t)peak * 256 + delta_q8) * kSampleRateMhz / ((int64_t)N * 1000));
+
+    // Fração da energia útil por banda
+    for (int b = 0; b < SPECTRAL_BANDS; b++) {
+        uint64_t e = 0;
+        for (int k = kTab.band_start[b]; k < kTab.band_start[b + 1]; k++) e += p[k];
+        f[1 + b] = (int32_t)((e * 256 + t / 2) / t);
+    }
+
+    // H = log2(T) - sum(P log2 P) / T, dividida pelo máximo log2(bins)
+    const int bins = M + 1 - lo;
+    if (bins > 1) {
+        int64_t h_q16 = (int64_t)ilog2_q16(t) - (int64_t)(sum_plog / t);
+        int64_t ent = h_q16 * 256 / ilog2_q16((uint64_t)bins);
+        if (ent < 0) ent = 0;
+        if (ent > 256) ent = 256;
+        f[1 + SPECTRAL_BANDS] = (int32_t)ent;
+    }
+}
+
+extern "C" void spectral_extract(SpectralWindow *sw, float *f) {
+    int32_t q[SPECTRAL_NUM_FEATURES];
+    spectral_extract_q(sw, q);
+    for (int i = 0; i < SPECTRAL_NUM_FEATURES; i++) {
+        f[i] = (float)q[i] * (1.0f / (1 << FEATURE_Q_FRAC_BITS));
+    }
+}
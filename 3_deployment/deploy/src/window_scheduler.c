@@ -0,0 +1,61 @@
+#include "include/window_scheduler.h"
+
+void scheduler_init(WindowScheduler *s, int hop) {
+    scheduler_set_hop(s, hop);
+    scheduler_set_anytime(s, 0, 1);
+    scheduler_reset(s);
+    s->fired = 0;
+    s->early = 0;
+    s->skipped = 0;
+}
+
+void scheduler_set_hop(WindowScheduler *s, int hop) {
+    s->hop = hop < 1 ? 1 : hop;
+}
+
+void scheduler_set_anytime(WindowScheduler *s, int min_samples, int step) {
+    // Uma amostra só não tem desvio nem cruzamentos
+    if (min_samples == 1) min_samples = 2;
+    if (min_samples < 0) min_samples = 0;
+    if (min_samples > WINDOW_SIZE) min_samples = WINDOW_SIZE;
+    s->min_samples = min_samples;
+    s->step = step < 1 ? 1 : step;
+}
+
+void scheduler_reset(WindowScheduler *s) {
+    window_init(&s->win);
+    s->since_fire = 0;
+    s->full_fired = false;
+    s->settled = false;
+    s->provisional = false;
+}
+
+void scheduler_settle(WindowScheduler *s) {
+    s->settled = true;
+}
+
+bool scheduler_add_sample(WindowScheduler *s, int16_t *accel, int16_t *gyro) {
+    window_add_sample(&s->win, accel, gyro);
+    if (!window_is_ready(&s->win)) {
+        int n = s->win.count;
+        if (s->min_samples == 0 || s->settled || n < s->min_samples || (n - s->min_samples) % s->step != 0) {
+            return false;
+        }
+        s->provisional = true;
+        s->fired++;
+        s->early++;
+        return true;
+    }
+    s->provisional = false;
+
+    // Primeira janela cheia sempre dispara; depois, a cada hop amostras
+    if (s->full_fired && ++s->since_fire < s->hop) {
+        s->skipped++;
+        return false;
+    }
+
+    s->full_fired = true;
+    s->since_fire = 0;
+    s->fired++;
+    return true;
+}